@@ -1,10 +1,12 @@
 #pragma once
 
 #include "../common/BaseCache.hpp"
+#include "../common/Weigher.hpp"
 #include "../lfu/lfu.hpp"
 #include "../lru/lru.hpp"
 #include "ArcLfuPart/ArcLfuPart.hpp"
 #include "ArcLruPart/ArcLruPart.hpp"
+#include <cstdint>
 #include <unordered_map>
 
 template <typename KeyType, typename ValueType>
@@ -16,6 +18,8 @@ class ARCCache : public BaseCache<KeyType, ValueType>
     std::unique_ptr<ArcLruPart<KeyType, ValueType>> lruPart_; // LRU部分缓存
     std::unique_ptr<ArcLfuPart<KeyType, ValueType>> lfuPart_; // LFU部分缓存
 
+    Weigher<KeyType, ValueType> weigher_; // 条目权重函数，为空时按条目计数
+
   public:
     /**
      * @brief ARC Cache 构造函数
@@ -24,7 +28,49 @@ class ARCCache : public BaseCache<KeyType, ValueType>
      */
     ARCCache(int capacity, int maxAverageFreq);
 
-    bool      get(KeyType key, ValueType& result) override;
-    ValueType get(KeyType key) override;
-    void      put(KeyType key, ValueType value) override;
+    /**
+     * @brief 按权重计容量的 ARC Cache
+     * @param capacity LRU 部分和 LFU 部分的总权重上限（如字节数）
+     * @param maxAverageFreq LFU 部分的最大平均频率
+     * @param weigher 条目权重函数，幽灵命中时两部分之间按该条目的权重转移容量
+     * @param admissionFraction 权重超过 capacity * admissionFraction 的条目拒绝写入
+     */
+    ARCCache(std::int64_t capacity, int maxAverageFreq, Weigher<KeyType, ValueType> weigher,
+             double admissionFraction = 1.0);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    /**
+     * @brief 设置移除监听器，listener 为空时关闭
+     *
+     * 从两个部分淘汰的条目进入幽灵列表，仍能查到，从幽灵列表淘汰时才产生 Size 事件；幽灵命中
+     * 把条目移回某个部分不产生事件，覆盖产生 Replaced 事件。ARC 没有过期和主动删除。事件在
+     * 释放相应部分的锁之后由触发移除的线程投递，监听器里可以再访问缓存。
+     */
+    void setRemovalListener(RemovalListener<KeyType, ValueType> listener);
+
+    /**
+     * @brief 统计快照：查询和写入在 ARC 层计数，幽灵命中的 get 同时算命中；
+     *        淘汰、覆盖、条目数和权重取自两个部分，幽灵列表不计入
+     */
+    void       setStatsEnabled(bool enabled) override;
+    CacheStats stats() const override;
+
+    /**
+     * @brief 查询和写入的延迟在 ARC 层记录；两个部分各用一个内部记录器，只取它们的淘汰和维护延迟
+     */
+    void          setLatencyRecorder(std::shared_ptr<LatencyRecorder> recorder) override;
+    LatencyReport latency() const override;
+
+  private:
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value);
+
+    // 条目的权重，即幽灵命中时两部分之间转移的容量
+    std::int64_t weigh(const KeyType& key, const ValueType& value) const;
 };
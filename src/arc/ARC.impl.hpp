@@ -5,11 +5,22 @@
 
 template <typename KeyType, typename ValueType>
 ARCCache<KeyType, ValueType>::ARCCache(int capacity, int maxAverageFreq)
-    : lruGhost_(std::make_shared<LRUCache<KeyType, ValueType>>(capacity))
-    , lfuGhost_(std::make_shared<LRUCache<KeyType, ValueType>>(capacity))
-    , lruPart_(std::make_unique<ArcLruPart<KeyType, ValueType>>(capacity, lruGhost_))
-    , lfuPart_(
-          std::make_unique<ArcLfuPart<KeyType, ValueType>>(capacity, maxAverageFreq, lfuGhost_))
+    : ARCCache(capacity, maxAverageFreq, Weigher<KeyType, ValueType>{})
+{
+}
+
+template <typename KeyType, typename ValueType>
+ARCCache<KeyType, ValueType>::ARCCache(std::int64_t capacity, int maxAverageFreq,
+                                       Weigher<KeyType, ValueType> weigher,
+                                       double admissionFraction)
+    // 幽灵列表同样按权重计容量，记住的是最近淘汰的那部分权重
+    : lruGhost_(std::make_shared<LRUCache<KeyType, ValueType>>(capacity, weigher))
+    , lfuGhost_(std::make_shared<LRUCache<KeyType, ValueType>>(capacity, weigher))
+    , lruPart_(std::make_unique<ArcLruPart<KeyType, ValueType>>(
+          capacity, lruGhost_, weigher, admissionFraction))
+    , lfuPart_(std::make_unique<ArcLfuPart<KeyType, ValueType>>(
+          capacity, maxAverageFreq, lfuGhost_, weigher, admissionFraction))
+    , weigher_(std::move(weigher))
 {
     log("{ARC Constructor} ARC Cache initialized with capacity=",
         capacity,
@@ -19,14 +30,17 @@ ARCCache<KeyType, ValueType>::ARCCache(int capacity, int maxAverageFreq)
 }
 
 template <typename KeyType, typename ValueType>
-bool ARCCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
+bool ARCCache<KeyType, ValueType>::get(const KeyType& key, ValueType& result)
 {
+    LatencyScope timing(this->latency_.get(), LatencyOp::GetMiss);
     log("{ARC get} Looking for key: ", key, "\n");
 
     // 首先在LRU部分查找
     if (lruPart_->get(key, result))
     {
         log("{ARC get} Found in LRU part: ", key, " = ", result, "\n");
+        this->stats_.hit();
+        timing.setOp(LatencyOp::GetHit);
         return true;
     }
 
@@ -34,42 +48,53 @@ bool ARCCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
     if (lfuPart_->get(key, result))
     {
         log("{ARC get} Found in LFU part: ", key, " = ", result, "\n");
+        this->stats_.hit();
+        timing.setOp(LatencyOp::GetHit);
         return true;
     }
 
     // 在LRU幽灵列表中查找，如果找到则移动到LFU部分
-    if (lruGhost_->get(key, result))
+    if (lruGhost_->peek(key, result))
     {
         log("{ARC get} Found in LRU ghost list: ", key, " -> promoting to LFU part\n");
         lfuPart_->put(key, result);
         lruGhost_->removeByKey(key);
 
-        // 使用简化的容量管理策略
-        lruPart_->changeCapacity(-1);
-        lfuPart_->changeCapacity(1);
-        log("{ARC get} Adjusted capacities: LRU-1, LFU+1\n");
+        // 使用简化的容量管理策略：按条目权重转移容量，未设置权重函数时为 1
+        std::int64_t weight = weigh(key, result);
+        lruPart_->changeCapacity(-weight);
+        lfuPart_->changeCapacity(weight);
+        log("{ARC get} Adjusted capacities: LRU-", weight, ", LFU+", weight, "\n");
+        this->stats_.hit();
+        timing.setOp(LatencyOp::GetHit);
+        this->stats_.ghostHit();
         return true;
     }
 
     // 在LFU幽灵列表中查找，如果找到则移动到LRU部分
-    if (lfuGhost_->get(key, result))
+    if (lfuGhost_->peek(key, result))
     {
         log("{ARC get} Found in LFU ghost list: ", key, " -> promoting to LRU part\n");
         lruPart_->put(key, result);
         lfuGhost_->removeByKey(key);
 
-        lruPart_->changeCapacity(1);
-        lfuPart_->changeCapacity(-1);
+        std::int64_t weight = weigh(key, result);
+        lruPart_->changeCapacity(weight);
+        lfuPart_->changeCapacity(-weight);
+        this->stats_.hit();
+        timing.setOp(LatencyOp::GetHit);
+        this->stats_.ghostHit();
         return true;
     }
 
     // 未找到
     log("{ARC get} Key not found: ", key, "\n");
+    this->stats_.miss();
     return false;
 }
 
 template <typename KeyType, typename ValueType>
-ValueType ARCCache<KeyType, ValueType>::get(KeyType key)
+ValueType ARCCache<KeyType, ValueType>::get(const KeyType& key)
 {
     ValueType result{};
     get(key, result);
@@ -77,52 +102,153 @@ ValueType ARCCache<KeyType, ValueType>::get(KeyType key)
 }
 
 template <typename KeyType, typename ValueType>
-void ARCCache<KeyType, ValueType>::put(KeyType key, ValueType value)
+void ARCCache<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+void ARCCache<KeyType, ValueType>::put(KeyType&& key, ValueType&& value)
+{
+    putImpl(std::move(key), std::move(value));
+}
+
+template <typename KeyType, typename ValueType>
+bool ARCCache<KeyType, ValueType>::peek(const KeyType& key, ValueType& result) const
+{
+    // 与 get 的可见范围一致：两个部分以及幽灵列表
+    return lruPart_->peek(key, result) || lfuPart_->peek(key, result) ||
+           lruGhost_->peek(key, result) || lfuGhost_->peek(key, result);
+}
+
+template <typename KeyType, typename ValueType>
+bool ARCCache<KeyType, ValueType>::contains(const KeyType& key) const
+{
+    return lruPart_->contains(key) || lfuPart_->contains(key) || lruGhost_->contains(key) ||
+           lfuGhost_->contains(key);
+}
+
+template <typename KeyType, typename ValueType>
+void ARCCache<KeyType, ValueType>::setRemovalListener(RemovalListener<KeyType, ValueType> listener)
+{
+    // 幽灵命中时 removeByKey 把条目移回某个部分，不是移除
+    RemovalListener<KeyType, ValueType> ghostListener;
+    if (listener)
+        ghostListener = [listener](const KeyType& key, const ValueType& value, RemovalCause cause)
+        {
+            if (cause != RemovalCause::Explicit)
+                listener(key, value, cause);
+        };
+    lruGhost_->setRemovalListener(ghostListener);
+    lfuGhost_->setRemovalListener(std::move(ghostListener));
+    lruPart_->setRemovalListener(listener);
+    lfuPart_->setRemovalListener(std::move(listener));
+}
+
+template <typename KeyType, typename ValueType>
+void ARCCache<KeyType, ValueType>::setStatsEnabled(bool enabled)
+{
+    this->stats_.setEnabled(enabled);
+    lruPart_->setStatsEnabled(enabled);
+    lfuPart_->setStatsEnabled(enabled);
+}
+
+template <typename KeyType, typename ValueType>
+CacheStats ARCCache<KeyType, ValueType>::stats() const
+{
+    CacheStats stats = this->stats_.snapshot();
+    CacheStats parts = lruPart_->stats();
+    parts += lfuPart_->stats();
+    stats.evictions        = parts.evictions;
+    stats.expirations      = parts.expirations;
+    stats.replacements     = parts.replacements;
+    stats.explicitRemovals = parts.explicitRemovals;
+    stats.size             = parts.size;
+    stats.weight           = parts.weight;
+    return stats;
+}
+
+template <typename KeyType, typename ValueType>
+void ARCCache<KeyType, ValueType>::setLatencyRecorder(std::shared_ptr<LatencyRecorder> recorder)
 {
+    // 两个部分的查询和写入嵌套在 ARC 的操作里，不能与 ARC 层共用记录器
+    lruPart_->setLatencyEnabled(recorder != nullptr);
+    lfuPart_->setLatencyEnabled(recorder != nullptr);
+    this->latency_ = std::move(recorder);
+}
+
+template <typename KeyType, typename ValueType>
+LatencyReport ARCCache<KeyType, ValueType>::latency() const
+{
+    LatencyReport report = BaseCache<KeyType, ValueType>::latency();
+    for (const LatencyReport& part : {lruPart_->latency(), lfuPart_->latency()})
+    {
+        report[LatencyOp::Evict] += part[LatencyOp::Evict];
+        report[LatencyOp::Maintenance] += part[LatencyOp::Maintenance];
+    }
+    return report;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K, typename V>
+void ARCCache<KeyType, ValueType>::putImpl(K&& key, V&& value)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Put);
     log("{ARC put} Inserting key: ", key, ", value: ", value, "\n");
-    ValueType temp{};
+    this->stats_.put();
 
+    // 用 contains 探测，不改变各部分的访问顺序和频次
     // 如果key已在LRU部分，更新值
-    if (lruPart_->get(key, temp))
+    if (lruPart_->contains(key))
     {
-        log("{ARC put} Updating existing key in LRU part: ", key, " (", temp, " -> ", value, ")\n");
-        lruPart_->put(key, value);
+        log("{ARC put} Updating existing key in LRU part: ", key, "\n");
+        lruPart_->put(std::forward<K>(key), std::forward<V>(value));
         return;
     }
 
     // 如果key已在LFU部分，更新值
-    if (lfuPart_->get(key, temp))
+    if (lfuPart_->contains(key))
     {
-        log("{ARC put} Updating existing key in LFU part: ", key, " (", temp, " -> ", value, ")\n");
-        lfuPart_->put(key, value);
+        log("{ARC put} Updating existing key in LFU part: ", key, "\n");
+        lfuPart_->put(std::forward<K>(key), std::forward<V>(value));
         return;
     }
 
     // 如果key在LRU幽灵列表中，移动到LFU部分
-    if (lruGhost_->get(key, temp))
+    if (lruGhost_->contains(key))
     {
         log("{ARC put} Found in LRU ghost list: ", key, " -> promoting to LFU part\n");
-        lfuPart_->put(key, value);
+        this->stats_.ghostHit();
+        std::int64_t weight = weigh(key, value);
         lruGhost_->removeByKey(key);
+        lfuPart_->put(std::forward<K>(key), std::forward<V>(value));
 
-        lruPart_->changeCapacity(-1);
-        lfuPart_->changeCapacity(1);
+        lruPart_->changeCapacity(-weight);
+        lfuPart_->changeCapacity(weight);
         return;
     }
 
     // 如果key在LFU幽灵列表中，移动到LRU部分
-    if (lfuGhost_->get(key, temp))
+    if (lfuGhost_->contains(key))
     {
         log("{ARC put} Found in LFU ghost list: ", key, " -> promoting to LRU part\n");
-        lruPart_->put(key, value);
+        this->stats_.ghostHit();
+        std::int64_t weight = weigh(key, value);
         lfuGhost_->removeByKey(key);
+        lruPart_->put(std::forward<K>(key), std::forward<V>(value));
 
-        lruPart_->changeCapacity(1);
-        lfuPart_->changeCapacity(-1);
+        lruPart_->changeCapacity(weight);
+        lfuPart_->changeCapacity(-weight);
         return;
     }
 
     // 新key，默认插入到LRU部分
     log("{ARC put} New key: ", key, " -> inserting to LRU part\n");
-    lruPart_->put(key, value);
+    lruPart_->put(std::forward<K>(key), std::forward<V>(value));
+}
+
+template <typename KeyType, typename ValueType>
+std::int64_t ARCCache<KeyType, ValueType>::weigh(const KeyType& key, const ValueType& value) const
+{
+    return weigher_ ? static_cast<std::int64_t>(weigher_(key, value)) : 1;
 }
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../../common/BaseCache.hpp"
+#include "../../common/FlatMap.hpp"
+#include "../../common/IntrusiveList.hpp"
+#include "../../common/Node.hpp"
+#include "../../common/NodePool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief 单锁 ARC 缓存（按 Megiddo & Modha 的原始算法实现）
+ *
+ * T1 存放只访问过一次的条目，T2 存放访问过至少两次的条目；B1/B2 分别是从 T1/T2 淘汰的幽灵记录，只保存键。
+ * 自适应目标 p 表示 T1 的期望大小：B1 命中说明 T1 太小，p 增大；B2 命中说明 T2 太小，p 减小。
+ * 四个链表共用一个索引和一把锁，一次查找即可确定键所在的链表。
+ */
+template <typename KeyType, typename ValueType>
+class AdaptiveARCCache : public BaseCache<KeyType, ValueType>
+{
+    using NodeType  = Node<KeyType, ValueType>;
+    using NodePtr   = NodeType*;
+    using GhostType = GhostNode<KeyType>;
+    using GhostPtr  = GhostType*;
+
+    enum class ListId : std::uint8_t
+    {
+        T1, // 最近访问一次
+        T2, // 最近访问至少两次
+        B1, // 从 T1 淘汰的幽灵记录
+        B2, // 从 T2 淘汰的幽灵记录
+    };
+
+    struct Entry
+    {
+        NodePtr  node{nullptr};  // T1/T2 中的节点
+        GhostPtr ghost{nullptr}; // B1/B2 中的幽灵记录
+        ListId   list{ListId::T1};
+    };
+
+    // 索引的取键方式：键存放在节点或幽灵记录中，索引槽位不另存一份
+    struct EntryKey
+    {
+        const KeyType& operator()(const Entry& entry) const
+        {
+            return entry.node ? entry.node->key : entry.ghost->key;
+        }
+    };
+
+    using EntryMap = FlatMap<KeyType, Entry, DefaultHash<KeyType>, std::equal_to<>, EntryKey>;
+
+    int capacity_; // 缓存容量 c，幽灵记录最多也是 c 条
+    int p_{};      // T1 的目标大小，范围 [0, c]
+
+    IntrusiveList<NodeType>  t1_;
+    IntrusiveList<NodeType>  t2_;
+    IntrusiveList<GhostType> b1_;
+    IntrusiveList<GhostType> b2_;
+    EntryMap                 index_;     // key->所在链表及节点
+    NodePool<NodeType>       pool_;      // 缓存节点池
+    NodePool<GhostType>      ghostPool_; // 幽灵记录池
+    mutable std::mutex       mutex_;     // 命中也会调整链表，使用互斥锁
+
+  public:
+    /**
+     * @param capacity 缓存容量，另外最多保留同样数量的幽灵键
+     */
+    AdaptiveARCCache(int capacity);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    /**
+     * @brief 当前 T1 的目标大小
+     */
+    int target() const;
+
+    /**
+     * @brief 统计快照，ghostHits 是 put 命中 B1/B2、调整 p 的次数（get 的幽灵命中只算未命中）
+     */
+    CacheStats stats() const override;
+
+  private:
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value);
+
+    /**
+     * @brief 命中 T1/T2 后移动到 T2 头部
+     */
+    void onHit(Entry& entry);
+
+    /**
+     * @brief 幽灵命中时调整目标 p
+     */
+    void adapt(ListId ghostList);
+
+    /**
+     * @brief 淘汰一个缓存条目并记入对应的幽灵链表（论文中的 REPLACE）
+     * @param inB2 本次请求的键是否命中 B2
+     */
+    void replace(bool inB2);
+
+    /**
+     * @brief 删除幽灵链表中最旧的记录
+     */
+    void dropGhost(IntrusiveList<GhostType>& list);
+};
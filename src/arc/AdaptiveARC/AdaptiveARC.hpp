@@ -0,0 +1,4 @@
+#pragma once
+
+#include "AdaptiveARC.decl.hpp"
+#include "AdaptiveARC.impl.hpp"
\ No newline at end of file
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "../../utils/log.hpp"
+#include "AdaptiveARC.decl.hpp"
+#include <algorithm>
+
+template <typename KeyType, typename ValueType>
+AdaptiveARCCache<KeyType, ValueType>::AdaptiveARCCache(int capacity)
+    : capacity_(std::max(capacity, 1))
+    , index_(capacity_ * 2)
+    , pool_(std::clamp(capacity_, 1, 4096))
+    , ghostPool_(std::clamp(capacity_, 1, 4096))
+{
+}
+
+template <typename KeyType, typename ValueType>
+bool AdaptiveARCCache<KeyType, ValueType>::get(const KeyType& key, ValueType& result)
+{
+    LatencyScope                timing(this->latency_.get(), LatencyOp::GetMiss);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Entry* entry = index_.find(key);
+    if (!entry)
+    {
+        this->stats_.miss();
+        log("{AdaptiveARC get} Key not found: ", key, "\n");
+        return false;
+    }
+
+    if (entry->list == ListId::B1 || entry->list == ListId::B2)
+    {
+        // 幽灵命中没有值可返回，按未命中处理；p 只由之后把键放入 T2 的 put 调整一次
+        log("{AdaptiveARC get} Ghost hit: ", key, "\n");
+        this->stats_.miss();
+        return false;
+    }
+    this->stats_.hit();
+    timing.setOp(LatencyOp::GetHit);
+
+    onHit(*entry);
+    result = entry->node->value;
+    log("{AdaptiveARC get} Found key: ", key, " = ", result, "\n");
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType AdaptiveARCCache<KeyType, ValueType>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType>
+void AdaptiveARCCache<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+void AdaptiveARCCache<KeyType, ValueType>::put(KeyType&& key, ValueType&& value)
+{
+    putImpl(std::move(key), std::move(value));
+}
+
+template <typename KeyType, typename ValueType>
+bool AdaptiveARCCache<KeyType, ValueType>::peek(const KeyType& key, ValueType& result) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry*                entry = index_.find(key);
+    if (!entry || !entry->node)
+        return false;
+    result = entry->node->value;
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+bool AdaptiveARCCache<KeyType, ValueType>::contains(const KeyType& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry*                entry = index_.find(key);
+    return entry && entry->node;
+}
+
+template <typename KeyType, typename ValueType>
+int AdaptiveARCCache<KeyType, ValueType>::target() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return p_;
+}
+
+template <typename KeyType, typename ValueType>
+CacheStats AdaptiveARCCache<KeyType, ValueType>::stats() const
+{
+    CacheStats                  stats = this->stats_.snapshot();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.size   = static_cast<std::size_t>(t1_.size() + t2_.size());
+    stats.weight = static_cast<std::int64_t>(stats.size);
+    return stats;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K, typename V>
+void AdaptiveARCCache<KeyType, ValueType>::putImpl(K&& key, V&& value)
+{
+    LatencyScope                timing(this->latency_.get(), LatencyOp::Put);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::size_t hash  = index_.hashOf(key);
+    Entry*      entry = index_.find(key, hash);
+    this->stats_.put();
+
+    // 情况 I：缓存命中，更新值
+    if (entry && entry->node)
+    {
+        this->stats_.removal(RemovalCause::Replaced);
+        log("{AdaptiveARC put} Update key: ", key, "\n");
+        entry->node->value = std::forward<V>(value);
+        onHit(*entry);
+        return;
+    }
+
+    if (entry)
+    {
+        // 情况 II/III：幽灵命中，调整 p 后腾出位置，键直接进入 T2
+        bool inB2 = entry->list == ListId::B2;
+        log("{AdaptiveARC put} Ghost hit: ", key, inB2 ? " in B2\n" : " in B1\n");
+        this->stats_.ghostHit();
+        adapt(entry->list);
+
+        // 索引条目原地改为指向新节点，再回收幽灵记录：replace 查找索引时不会经过已回收的记录
+        GhostPtr ghost = entry->ghost;
+        NodePtr  node  = pool_.acquire();
+        node->key      = std::forward<K>(key);
+        node->value    = std::forward<V>(value);
+        node->hash     = hash;
+        entry->node    = node;
+        entry->ghost   = nullptr;
+        entry->list    = ListId::T2;
+        (inB2 ? b2_ : b1_).unlink(ghost);
+        ghostPool_.release(ghost);
+        if (t1_.size() + t2_.size() >= capacity_)
+            replace(inB2);
+        t2_.pushFront(node);
+        log("{AdaptiveARC put} Insert key: ", node->key, " into T2, p=", p_, "\n");
+        return;
+    }
+
+    // 情况 IV：完全未命中
+    int l1 = t1_.size() + b1_.size();
+    if (l1 >= capacity_)
+    {
+        if (t1_.size() < capacity_)
+        {
+            dropGhost(b1_);
+            if (t1_.size() + t2_.size() >= capacity_)
+                replace(false);
+        }
+        else
+        {
+            // B1 为空且 T1 已满，直接丢弃 T1 最旧的条目，不留幽灵记录
+            LatencyScope evictTiming(this->latency_.get(), LatencyOp::Evict);
+            NodePtr      victim = t1_.back();
+            log("{AdaptiveARC put} Evict from T1 without ghost: ", victim->key, "\n");
+            this->stats_.removal(RemovalCause::Size);
+            t1_.unlink(victim);
+            index_.erase(victim->key, victim->hash);
+            pool_.release(victim);
+        }
+    }
+    else
+    {
+        int total = l1 + t2_.size() + b2_.size();
+        if (total >= capacity_ * 2)
+            dropGhost(b2_);
+        if (t1_.size() + t2_.size() >= capacity_)
+            replace(false);
+    }
+
+    NodePtr node = pool_.acquire();
+    node->key    = std::forward<K>(key);
+    node->value  = std::forward<V>(value);
+    node->hash   = hash;
+    index_.insert(hash, Entry{node, nullptr, ListId::T1});
+    t1_.pushFront(node);
+    log("{AdaptiveARC put} Insert key: ", node->key, " into T1, p=", p_, "\n");
+}
+
+template <typename KeyType, typename ValueType>
+void AdaptiveARCCache<KeyType, ValueType>::onHit(Entry& entry)
+{
+    if (entry.list == ListId::T1)
+    {
+        t1_.unlink(entry.node);
+        t2_.pushFront(entry.node);
+        entry.list = ListId::T2;
+    }
+    else
+        t2_.moveToFront(entry.node);
+}
+
+template <typename KeyType, typename ValueType>
+void AdaptiveARCCache<KeyType, ValueType>::adapt(ListId ghostList)
+{
+    int b1 = b1_.size();
+    int b2 = b2_.size();
+    if (ghostList == ListId::B1)
+        p_ = std::min(p_ + std::max(b2 / std::max(b1, 1), 1), capacity_);
+    else
+        p_ = std::max(p_ - std::max(b1 / std::max(b2, 1), 1), 0);
+    log("{AdaptiveARC adapt} p=", p_, "\n");
+}
+
+template <typename KeyType, typename ValueType>
+void AdaptiveARCCache<KeyType, ValueType>::replace(bool inB2)
+{
+    int     t1     = t1_.size();
+    bool    fromT1 = t1 > 0 && (t1 > p_ || (inB2 && t1 == p_));
+    auto&   source = fromT1 ? t1_ : t2_;
+    auto&   ghosts = fromT1 ? b1_ : b2_;
+    NodePtr victim = source.back();
+    if (!victim)
+        return;
+
+    LatencyScope timing(this->latency_.get(), LatencyOp::Evict);
+    log("{AdaptiveARC replace} Evict ", victim->key, fromT1 ? " from T1\n" : " from T2\n");
+    this->stats_.removal(RemovalCause::Size);
+
+    // 节点回收，键转移到幽灵记录；索引条目原地改为指向幽灵记录。
+    // 索引从节点取键，要在键移走之前找到条目
+    Entry*   entry = index_.find(victim->key, victim->hash);
+    GhostPtr ghost = ghostPool_.acquire();
+    ghost->hash    = victim->hash;
+    ghost->key     = std::move(victim->key);
+    source.unlink(victim);
+    ghosts.pushFront(ghost);
+
+    entry->node  = nullptr;
+    entry->ghost = ghost;
+    entry->list  = fromT1 ? ListId::B1 : ListId::B2;
+    pool_.release(victim);
+}
+
+template <typename KeyType, typename ValueType>
+void AdaptiveARCCache<KeyType, ValueType>::dropGhost(IntrusiveList<GhostType>& list)
+{
+    GhostPtr ghost = list.back();
+    if (!ghost)
+        return;
+    list.unlink(ghost);
+    index_.erase(ghost->key, ghost->hash);
+    ghostPool_.release(ghost);
+}
@@ -2,6 +2,7 @@
 
 #include "../../lfu/LFU/LFU.hpp"
 #include "../../lru/LRU/LRU.hpp"
+#include <cstdint>
 #include <memory>
 
 template <typename KeyType, typename ValueType>
@@ -10,9 +11,18 @@ class ArcLfuPart : public LFUCache<KeyType, ValueType>
     std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_;
 
   public:
-    ArcLfuPart(int capacity, int maxAverageFreq,
-               std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_);
+    /**
+     * @brief 因容量被淘汰的条目通过移除监听器移入幽灵列表，在释放本部分的锁之后进行，两把锁不会嵌套
+     */
+    ArcLfuPart(std::int64_t capacity, int maxAverageFreq,
+               std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_,
+               Weigher<KeyType, ValueType> weigher = {}, double admissionFraction = 1.0);
 
-  protected:
-    void removeLast() override;
+    /**
+     * @brief 设置交给 ARC 调用方的监听器，listener 为空时关闭
+     *
+     * 因容量淘汰的条目仍移入幽灵列表，不交给 listener，其余事件在释放本部分的锁之后投递。
+     * 隐藏了基类的同名接口，幽灵列表的转移不会被替换掉。
+     */
+    void setRemovalListener(RemovalListener<KeyType, ValueType> listener);
 };
\ No newline at end of file
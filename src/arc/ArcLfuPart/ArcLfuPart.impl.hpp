@@ -5,28 +5,32 @@
 #include <memory>
 
 template <typename KeyType, typename ValueType>
-ArcLfuPart<KeyType, ValueType>::ArcLfuPart(int capacity, int maxAverageFreq,
-                                           std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_)
-    : LFUCache<KeyType, ValueType>(capacity, maxAverageFreq), ghostList_(ghostList_)
+ArcLfuPart<KeyType, ValueType>::ArcLfuPart(std::int64_t capacity, int maxAverageFreq,
+                                           std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_,
+                                           Weigher<KeyType, ValueType> weigher,
+                                           double admissionFraction)
+    : LFUCache<KeyType, ValueType>(capacity, maxAverageFreq, std::move(weigher), admissionFraction)
+    , ghostList_(ghostList_)
 {
+    setRemovalListener(nullptr);
 }
 
 template <typename KeyType, typename ValueType>
-void ArcLfuPart<KeyType, ValueType>::removeLast()
+void ArcLfuPart<KeyType, ValueType>::setRemovalListener(
+    RemovalListener<KeyType, ValueType> listener)
 {
-    auto node = this->getLastNode();
-    if (!node)
-    {
-        log("{ARC-LFU} Warning: getLastNode returned nullptr\n");
-        return;
-    }
-
-    auto key   = node->key;
-    auto value = node->value;
-    auto freq  = node->freq;
-
-    log("{ARC-LFU} Evicting last node: ", key, " (freq: ", freq, ") -> moving to LFU ghost list\n");
-    ghostList_->put(key, value);
-    this->remove(node, true);
-    this->decreaseTotalFreq(freq);
-}
\ No newline at end of file
+    LFUCache<KeyType, ValueType>::setRemovalListener(
+        [ghost = ghostList_.get(), listener = std::move(listener)](const KeyType&   key,
+                                                                   const ValueType& value,
+                                                                   RemovalCause     cause)
+        {
+            if (cause != RemovalCause::Size)
+            {
+                if (listener)
+                    listener(key, value, cause);
+                return;
+            }
+            log("{ARC-LFU} Evicted node: ", key, " -> moving to LFU ghost list\n");
+            ghost->put(key, value);
+        });
+}
@@ -5,28 +5,32 @@
 #include <memory>
 
 template <typename KeyType, typename ValueType>
-ArcLruPart<KeyType, ValueType>::ArcLruPart(int                                           capacity,
-                                           std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_)
-    : LRUCache<KeyType, ValueType>(capacity), ghostList_(ghostList_)
+ArcLruPart<KeyType, ValueType>::ArcLruPart(std::int64_t capacity,
+                                           std::shared_ptr<LRUCache<KeyType, ValueType>> ghostList_,
+                                           Weigher<KeyType, ValueType> weigher,
+                                           double admissionFraction)
+    : LRUCache<KeyType, ValueType>(capacity, std::move(weigher), admissionFraction)
+    , ghostList_(ghostList_)
 {
+    setRemovalListener(nullptr);
 }
 
 template <typename KeyType, typename ValueType>
-void ArcLruPart<KeyType, ValueType>::removeLast()
+void ArcLruPart<KeyType, ValueType>::setRemovalListener(
+    RemovalListener<KeyType, ValueType> listener)
 {
-    // 使用基类提供的安全接口检查
-    if (!this->hasValidNodes())
-    {
-        log("{ARC-LRU} Warning: No valid nodes to evict\n");
-        return;
-    }
-
-    auto lastNode = this->getLastNode();
-
-    auto key   = lastNode->key;
-    auto value = lastNode->value;
-
-    log("{ARC-LRU} Evicting last node: ", key, " -> moving to LRU ghost list\n");
-    ghostList_->put(key, value);
-    this->remove(lastNode, true);
-}
\ No newline at end of file
+    LRUCache<KeyType, ValueType>::setRemovalListener(
+        [ghost = ghostList_.get(), listener = std::move(listener)](const KeyType&   key,
+                                                                   const ValueType& value,
+                                                                   RemovalCause     cause)
+        {
+            if (cause != RemovalCause::Size)
+            {
+                if (listener)
+                    listener(key, value, cause);
+                return;
+            }
+            log("{ARC-LRU} Evicted node: ", key, " -> moving to LRU ghost list\n");
+            ghost->put(key, value);
+        });
+}
@@ -1,4 +1,5 @@
 #pragma once
 
 #include "ARC.decl.hpp"
-#include "ARC.impl.hpp"
\ No newline at end of file
+#include "ARC.impl.hpp"
+#include "AdaptiveARC/AdaptiveARC.hpp"
\ No newline at end of file
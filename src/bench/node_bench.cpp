@@ -0,0 +1,200 @@
+// 节点存储基准测试：对比旧的 shared_ptr/weak_ptr 链表节点与 NodePool 池化节点
+// 统计每个条目占用的堆内存字节数，以及 get/put 的平均耗时
+#include "../lru/LRU/LRU.hpp"
+#include "../utils/timer.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// 统计当前存活的堆内存字节数（替换全局 operator new/delete）
+static std::size_t g_liveBytes = 0;
+// 防止读取结果被编译器优化掉
+static volatile int g_sink = 0;
+
+void* operator new(std::size_t size)
+{
+    // 在块头部记录大小，便于 delete 时扣除
+    auto* raw = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!raw)
+        throw std::bad_alloc();
+    *raw = size;
+    g_liveBytes += size;
+    return reinterpret_cast<char*>(raw) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+    auto* raw = reinterpret_cast<std::size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    g_liveBytes -= *raw;
+    std::free(raw);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+
+// 对照组：与原实现相同的 shared_ptr/weak_ptr 节点 LRU
+template <typename KeyType, typename ValueType>
+class LegacyLRU
+{
+    struct LegacyNode
+    {
+        KeyType                     key;
+        ValueType                   value;
+        int                         freq{1};
+        std::weak_ptr<LegacyNode>   prev;
+        std::shared_ptr<LegacyNode> next;
+    };
+    using NodePtr = std::shared_ptr<LegacyNode>;
+
+    int                                  capacity_;
+    int                                  nodeCount_{};
+    NodePtr                              first_;
+    NodePtr                              last_;
+    std::unordered_map<KeyType, NodePtr> map_;
+
+  public:
+    LegacyLRU(int capacity)
+        : capacity_(capacity)
+        , first_(std::make_shared<LegacyNode>())
+        , last_(std::make_shared<LegacyNode>())
+    {
+        first_->next = last_;
+        last_->prev  = first_;
+    }
+
+    ~LegacyLRU()
+    {
+        // 逐个断开链表，避免 shared_ptr 递归析构过深
+        map_.clear();
+        while (first_->next != last_)
+        {
+            NodePtr node = first_->next;
+            remove(node);
+        }
+    }
+
+    bool get(const KeyType& key, ValueType& result)
+    {
+        auto it = map_.find(key);
+        if (it == map_.end())
+            return false;
+        NodePtr node = it->second;
+        remove(node);
+        insertFirst(node);
+        result = node->value;
+        return true;
+    }
+
+    void put(const KeyType& key, const ValueType& value)
+    {
+        auto it = map_.find(key);
+        if (it != map_.end())
+        {
+            NodePtr node = it->second;
+            node->value  = value;
+            remove(node);
+            insertFirst(node);
+            return;
+        }
+        if (nodeCount_ < capacity_)
+            nodeCount_++;
+        else
+        {
+            NodePtr victim = last_->prev.lock();
+            remove(victim);
+            map_.erase(victim->key);
+        }
+        auto node   = std::make_shared<LegacyNode>();
+        node->key   = key;
+        node->value = value;
+        map_[key]   = node;
+        insertFirst(node);
+    }
+
+  private:
+    void remove(const NodePtr& node)
+    {
+        NodePtr prev     = node->prev.lock();
+        prev->next       = node->next;
+        node->next->prev = prev;
+        node->next       = nullptr;
+    }
+
+    void insertFirst(const NodePtr& node)
+    {
+        node->prev         = first_;
+        node->next         = first_->next;
+        first_->next->prev = node;
+        first_->next       = node;
+    }
+};
+
+struct NodeBenchResult
+{
+    double bytesPerEntry; // 每条目堆内存
+    double nsPerOp;       // 每次操作耗时
+};
+
+template <typename Cache>
+NodeBenchResult runNodeBench(int capacity, int operations)
+{
+    std::size_t before = g_liveBytes;
+    Cache       cache(capacity);
+    for (int key = 0; key < capacity; ++key) cache.put(key, key);
+    double bytesPerEntry = static_cast<double>(g_liveBytes - before) / capacity;
+
+    // 80% 读，20% 写入；90% 的键取自预填的范围，其余在范围外：约 10% 的读未命中，
+    // 约 10% 的写入是新键，触发淘汰
+    std::mt19937     gen(42);
+    std::vector<int> keys(operations);
+    for (int i = 0; i < operations; ++i)
+        keys[i] = (gen() % 10 < 9) ? static_cast<int>(gen() % capacity)
+                                   : capacity + static_cast<int>(gen() % capacity);
+
+    int   sink = 0;
+    Timer timer("node bench", true);
+    for (int i = 0; i < operations; ++i)
+    {
+        int value;
+        if (i % 5 == 0)
+            cache.put(keys[i], i);
+        else if (cache.get(keys[i], value))
+            sink += value;
+    }
+    double elapsedMs = timer.getElapsedMilliseconds();
+    g_sink           = sink;
+
+    return {bytesPerEntry, elapsedMs * 1e6 / operations};
+}
+
+int main(int argc, char* argv[])
+{
+    int capacity   = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int operations = argc > 2 ? std::atoi(argv[2]) : 5000000;
+
+    std::cout << "=== 节点存储基准测试 ===" << std::endl;
+    std::cout << "条目数: " << capacity << ", 操作数: " << operations << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << std::left << std::setw(30) << "节点存储" << std::setw(20) << "字节/条目"
+              << "纳秒/操作" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    auto legacy = runNodeBench<LegacyLRU<int, int>>(capacity, operations);
+    auto pooled = runNodeBench<LRUCache<int, int>>(capacity, operations);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(30) << "shared_ptr/weak_ptr" << std::setw(20)
+              << legacy.bytesPerEntry << legacy.nsPerOp << std::endl;
+    std::cout << std::left << std::setw(30) << "NodePool" << std::setw(20) << pooled.bytesPerEntry
+              << pooled.nsPerOp << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    return 0;
+}
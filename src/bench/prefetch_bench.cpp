@@ -0,0 +1,109 @@
+// 批量查询预取基准测试：对比逐个 get 与分组预取的 getMany 在大缓存上的吞吐量
+// 用法：PrefetchBench [查询次数] [批大小] [条目数...]
+// 条目数默认 1M 与 10M；内存充足时可传入 100000000 测试 1 亿条目（约需 11GB 内存）
+#include "../lru/HashLRU/HashLRU.hpp"
+#include "../lru/LRU/LRU.hpp"
+#include "../utils/timer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// 防止读取结果被编译器优化掉
+static volatile std::uint64_t g_sink = 0;
+
+struct PrefetchBenchResult
+{
+    double serialMops; // 逐个 get 的吞吐量（百万次/秒）
+    double batchMops;  // getMany 的吞吐量（百万次/秒）
+};
+
+template <typename Cache>
+PrefetchBenchResult runPrefetchBench(Cache& cache, const std::vector<std::uint64_t>& keys,
+                                     std::size_t batch)
+{
+    std::vector<std::uint64_t> results(batch);
+    std::vector<std::uint64_t> hitBits((batch + 63) / 64);
+    std::uint64_t              sink = 0;
+
+    // 通过基类引用调用，与业务代码逐个 get 的方式一致
+    BaseCache<std::uint64_t, std::uint64_t>& base = cache;
+
+    Timer serialTimer("serial", true);
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        std::uint64_t value;
+        if (base.get(keys[i], value))
+            sink += value;
+    }
+    double serialMs = serialTimer.getElapsedMilliseconds();
+
+    Timer batchTimer("batch", true);
+    for (std::size_t begin = 0; begin + batch <= keys.size(); begin += batch)
+    {
+        base.getMany(&keys[begin], batch, results.data(), hitBits.data());
+        sink += results[0];
+    }
+    double batchMs = batchTimer.getElapsedMilliseconds();
+    g_sink         = sink;
+
+    double lookups = static_cast<double>(keys.size() / batch * batch);
+    return {keys.size() / serialMs / 1000.0, lookups / batchMs / 1000.0};
+}
+
+template <typename Cache, typename... Args>
+PrefetchBenchResult benchCache(std::size_t entries, std::size_t lookups, std::size_t batch,
+                               Args... args)
+{
+    Cache cache(static_cast<int>(entries), args...);
+    for (std::uint64_t key = 0; key < entries; key++) cache.put(key, key);
+
+    // 均匀随机访问全部条目，全部命中，工作集远大于末级缓存
+    std::mt19937_64            gen(42);
+    std::vector<std::uint64_t> keys(lookups);
+    for (auto& key : keys) key = gen() % entries;
+    return runPrefetchBench(cache, keys, batch);
+}
+
+void printRow(const std::string& name, std::size_t entries, const PrefetchBenchResult& result)
+{
+    std::cout << std::left << std::setw(12) << name << std::setw(14) << entries << std::setw(18)
+              << result.serialMops << std::setw(18) << result.batchMops
+              << result.batchMops / result.serialMops << "x" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t              lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    std::size_t              batch   = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    std::vector<std::size_t> sizes;
+    for (int i = 3; i < argc; i++) sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizes.empty())
+        sizes = {1000000, 10000000};
+    if (batch == 0)
+        batch = 1;
+
+    std::cout << "=== 批量查询预取基准测试 ===" << std::endl;
+    std::cout << "查询次数: " << lookups << ", 批大小: " << batch << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::left << std::setw(12) << "缓存" << std::setw(14) << "条目数" << std::setw(18)
+              << "逐个get(Mops)" << std::setw(18) << "getMany(Mops)" << "加速比" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (std::size_t entries : sizes)
+    {
+        using Key = std::uint64_t;
+        printRow("LRU", entries, benchCache<LRUCache<Key, Key>>(entries, lookups, batch));
+        printRow("HashLRU",
+                 entries,
+                 benchCache<HashLRUCache<Key, Key>>(entries, lookups, batch, 8));
+    }
+    std::cout << std::string(80, '-') << std::endl;
+
+    return 0;
+}
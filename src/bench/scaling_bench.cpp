@@ -0,0 +1,313 @@
+// 多线程扩展性基准测试：每种缓存在 1..N 个线程、不同读写比例下并发访问同一个实例，
+// 报告总吞吐量、扩展效率（相对单线程吞吐量 x 线程数）和各线程之间的公平性
+// 用法：ScalingBench [--threads N] [--reads 95,80,50] [--duration 毫秒] [--keys N]
+//                    [--capacity N] [--cache 名称] [--pin]
+// 线程数按 1, 2, 4, ... 翻倍直到 N（N 默认为硬件线程数）；--pin 把第 i 个线程绑定到第 i 个 CPU
+#include "../arc/arc.hpp"
+#include "../lfu/lfu.hpp"
+#include "../lru/lru.hpp"
+#include "../utils/text.hpp"
+#include "../utils/timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using Key   = std::uint64_t;
+using Cache = BaseCache<Key, Key>;
+
+struct ScalingConfig
+{
+    int              maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    std::vector<int> readPercents{95, 80, 50}; // 各轮的读比例（%）
+    int              durationMs = 500;         // 每轮的持续时间
+    std::size_t      keys       = 1000000;     // 键空间大小，按 Zipf(0.99) 分布访问
+    int              capacity   = 100000;      // 缓存容量
+    std::string      cacheName;                // 只测指定的缓存，为空时测全部
+    bool             pin        = false;       // 是否把线程绑定到 CPU
+};
+
+struct NamedCache
+{
+    std::string                             name;
+    std::function<std::unique_ptr<Cache>()> create;
+};
+
+struct ScalingResult
+{
+    double mops;     // 总吞吐量（百万次/秒）
+    double fairness; // Jain 公平性指数，1 表示各线程完成的操作数完全相同
+    double spread;   // 最慢线程与最快线程的操作数之比
+};
+
+// 每个线程的计数独占缓存行，计数本身不引入争用
+struct alignas(128) WorkerCounter
+{
+    std::uint64_t ops = 0;
+};
+
+// 每个线程预先生成的访问序列长度，循环使用，测量期间不调用随机数生成器
+static constexpr std::size_t kStreamLength = 1 << 18;
+
+// 防止读取结果被编译器优化掉，各线程结束时累加一次
+static std::atomic<std::uint64_t> g_sink{0};
+
+static void pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// Zipf(0.99) 的累积分布，按二分查找把均匀随机数映射为键的排名
+static std::vector<double> zipfCdf(std::size_t keys)
+{
+    std::vector<double> cdf(keys);
+    double              sum = 0;
+    for (std::size_t i = 0; i < keys; i++)
+    {
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), 0.99);
+        cdf[i] = sum;
+    }
+    for (double& value : cdf) value /= sum;
+    return cdf;
+}
+
+// 访问序列：键左移一位，最低位为 1 表示写入
+static std::vector<Key> makeStream(const std::vector<double>& cdf, int readPercent,
+                                   std::uint32_t seed)
+{
+    std::mt19937_64                        gen(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int>     percent(0, 99);
+    std::vector<Key>                       stream(kStreamLength);
+    for (Key& op : stream)
+    {
+        auto rank = static_cast<Key>(std::lower_bound(cdf.begin(), cdf.end(), uniform(gen))
+                                     - cdf.begin());
+        // 打散排名，热点键不会都落在相邻的哈希值上
+        Key key = rank * 0x9E3779B97F4A7C15ull >> 1;
+        op      = key << 1 | (percent(gen) >= readPercent ? 1 : 0);
+    }
+    return stream;
+}
+
+static ScalingResult runScaling(Cache& cache, const std::vector<std::vector<Key>>& streams,
+                                int threads, const ScalingConfig& config)
+{
+    std::vector<WorkerCounter> counters(threads);
+    std::vector<std::thread>   workers;
+    std::atomic<int>           ready{0};
+    std::atomic<bool>          start{false};
+    std::atomic<bool>          stop{false};
+
+    for (int t = 0; t < threads; t++)
+    {
+        workers.emplace_back(
+            [&, t]
+            {
+                if (config.pin)
+                    pinCurrentThread(t);
+                const std::vector<Key>& stream = streams[t];
+                std::uint64_t           ops    = 0;
+                std::uint64_t           sink   = 0;
+                ready.fetch_add(1);
+                while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+                // 每 64 次操作检查一次停止标志
+                for (std::size_t i = 0; !stop.load(std::memory_order_relaxed);)
+                {
+                    for (int n = 0; n < 64; n++, i = (i + 1) & (kStreamLength - 1))
+                    {
+                        Key op  = stream[i];
+                        Key key = op >> 1;
+                        if (op & 1)
+                            cache.put(key, key);
+                        else
+                        {
+                            Key value;
+                            if (cache.get(key, value))
+                                sink += value;
+                        }
+                    }
+                    ops += 64;
+                }
+                counters[t].ops = ops;
+                g_sink.fetch_add(sink, std::memory_order_relaxed);
+            });
+    }
+
+    while (ready.load() < threads) std::this_thread::yield();
+    Timer timer("scaling", true);
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(config.durationMs));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) worker.join();
+    double elapsedMs = timer.getElapsedMilliseconds();
+
+    double total   = 0;
+    double squares = 0;
+    double slowest = static_cast<double>(counters[0].ops);
+    double fastest = slowest;
+    for (const WorkerCounter& counter : counters)
+    {
+        auto ops = static_cast<double>(counter.ops);
+        total += ops;
+        squares += ops * ops;
+        slowest = std::min(slowest, ops);
+        fastest = std::max(fastest, ops);
+    }
+    return {total / elapsedMs / 1000.0,
+            squares > 0 ? total * total / (threads * squares) : 1.0,
+            fastest > 0 ? slowest / fastest : 1.0};
+}
+
+static std::vector<NamedCache> makeCaches(const ScalingConfig& config)
+{
+    int capacity = config.capacity;
+    int shards   = std::max(config.maxThreads, 1);
+    int history  = capacity * 2;
+    return {
+        {"LRU", [=] { return std::make_unique<LRUCache<Key, Key>>(capacity); }},
+        {"LRU-K", [=] { return std::make_unique<LRUKCache<Key, Key>>(2, capacity, history); }},
+        {"HashLRU", [=] { return std::make_unique<HashLRUCache<Key, Key>>(capacity, shards); }},
+        {"BufferedLRU", [=] { return std::make_unique<BufferedLRUCache<Key, Key>>(capacity); }},
+        {"Clock", [=] { return std::make_unique<ClockCache<Key, Key>>(capacity); }},
+        {"SLRU", [=] { return std::make_unique<SLRUCache<Key, Key>>(capacity); }},
+        {"HashSLRU", [=] { return std::make_unique<HashSLRUCache<Key, Key>>(capacity, shards); }},
+        {"LFU", [=] { return std::make_unique<LFUCache<Key, Key>>(capacity, 100); }},
+        {"HashLFU",
+         [=] { return std::make_unique<HashLFUCache<Key, Key>>(capacity, 100, shards); }},
+        {"TinyLFU", [=] { return std::make_unique<TinyLFUCache<Key, Key>>(capacity); }},
+        {"ARC", [=] { return std::make_unique<ARCCache<Key, Key>>(capacity / 2, 100); }},
+        {"AdaptiveARC", [=] { return std::make_unique<AdaptiveARCCache<Key, Key>>(capacity); }},
+    };
+}
+
+static std::vector<int> parseList(const std::string& text)
+{
+    std::vector<int> values;
+    std::size_t      begin = 0;
+    while (begin < text.size())
+    {
+        std::size_t end = text.find(',', begin);
+        if (end == std::string::npos)
+            end = text.size();
+        values.push_back(std::atoi(text.substr(begin, end - begin).c_str()));
+        begin = end + 1;
+    }
+    return values;
+}
+
+static bool parseArgs(int argc, char* argv[], ScalingConfig& config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg  = argv[i];
+        bool        more = i + 1 < argc;
+        if (arg == "--pin")
+            config.pin = true;
+        else if (arg == "--threads" && more)
+            config.maxThreads = std::atoi(argv[++i]);
+        else if (arg == "--reads" && more)
+            config.readPercents = parseList(argv[++i]);
+        else if (arg == "--duration" && more)
+            config.durationMs = std::atoi(argv[++i]);
+        else if (arg == "--keys" && more)
+            config.keys = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--capacity" && more)
+            config.capacity = std::atoi(argv[++i]);
+        else if (arg == "--cache" && more)
+            config.cacheName = argv[++i];
+        else
+            return false;
+    }
+    config.maxThreads = std::max(config.maxThreads, 1);
+    config.keys       = std::max<std::size_t>(config.keys, 1);
+    config.capacity   = std::max(config.capacity, 1);
+    for (int& percent : config.readPercents) percent = std::clamp(percent, 0, 100);
+    return !config.readPercents.empty();
+}
+
+int main(int argc, char* argv[])
+{
+    ScalingConfig config;
+    if (!parseArgs(argc, argv, config))
+    {
+        std::cerr << "用法: " << argv[0]
+                  << " [--threads N] [--reads 95,80,50] [--duration 毫秒] [--keys N]"
+                     " [--capacity N] [--cache 名称] [--pin]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < config.maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(config.maxThreads);
+
+    std::cout << "=== 多线程扩展性基准测试 ===" << std::endl;
+    std::cout << "最大线程数: " << config.maxThreads << ", 键空间: " << config.keys
+              << " (Zipf 0.99), 容量: " << config.capacity << ", 每轮: " << config.durationMs
+              << " ms, 绑定CPU: " << (config.pin ? "是" : "否") << std::endl;
+
+    std::vector<double> cdf = zipfCdf(config.keys);
+    std::cout << std::fixed;
+    for (int readPercent : config.readPercents)
+    {
+        // 同一读比例下所有缓存使用相同的访问序列
+        std::vector<std::vector<Key>> streams;
+        for (int t = 0; t < config.maxThreads; t++)
+            streams.push_back(makeStream(cdf, readPercent, 12345 + t));
+
+        std::cout << "\n--- 读 " << readPercent << "% / 写 " << 100 - readPercent << "% ---"
+                  << std::endl;
+        std::cout << pad("缓存", 14, true) << pad("线程", 8, true) << pad("Mops/s", 8, false)
+                  << pad("扩展效率", 12, false) << pad("公平性", 12, false)
+                  << pad("最慢/最快", 12, false) << std::endl;
+        std::cout << std::string(66, '-') << std::endl;
+
+        for (const NamedCache& entry : makeCaches(config))
+        {
+            if (!config.cacheName.empty() && entry.name != config.cacheName)
+                continue;
+            double single = 0;
+            for (int threads : threadCounts)
+            {
+                // 每轮使用新的实例，先按访问序列预热到稳定状态
+                std::unique_ptr<Cache> cache = entry.create();
+                for (Key op : streams[0]) cache->put(op >> 1, op >> 1);
+
+                ScalingResult result = runScaling(*cache, streams, threads, config);
+                if (threads == 1)
+                    single = result.mops;
+                double efficiency = single > 0 ? result.mops / (single * threads) : 0.0;
+                std::cout << std::left << std::setw(14) << entry.name << std::setw(8) << threads
+                          << std::right << std::setprecision(2) << std::setw(8) << result.mops
+                          << std::setw(11) << efficiency * 100 << "%" << std::setprecision(3)
+                          << std::setw(12) << result.fairness << std::setw(12) << result.spread
+                          << std::endl;
+            }
+        }
+    }
+    return 0;
+}
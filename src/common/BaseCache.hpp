@@ -1,10 +1,139 @@
 #pragma once
 
+#include "CacheStats.hpp"
+#include "LatencyHistogram.hpp"
+#include "../utils/trace.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 template <typename KeyType, typename ValueType>
 class BaseCache
 {
+  protected:
+    StatsCounter                     stats_;   // 命中、写入、移除等计数，默认关闭
+    std::shared_ptr<LatencyRecorder> latency_; // 各操作的延迟记录器，为空时不读取时钟
+    std::uint16_t                    traceShard_{}; // 追踪事件中的分片编号，由分片缓存设置
+
   public:
-    virtual bool      get(KeyType key, ValueType& result) = 0;
-    virtual ValueType get(KeyType key)                    = 0;
-    virtual void      put(KeyType key, ValueType value)   = 0;
-};
\ No newline at end of file
+    virtual ~BaseCache() = default;
+
+    virtual bool      get(const KeyType& key, ValueType& result)      = 0;
+    virtual ValueType get(const KeyType& key)                         = 0;
+    virtual void      put(const KeyType& key, const ValueType& value) = 0;
+    virtual void      put(KeyType&& key, ValueType&& value)           = 0;
+
+    // 只读查询：不改变最近访问顺序和访问频次
+    virtual bool peek(const KeyType& key, ValueType& result) const = 0;
+    virtual bool contains(const KeyType& key) const                = 0;
+
+    /**
+     * @brief 批量查询，命中的键把值写入 results[i]，未命中的 results[i] 保持不变
+     * @param hitBits 命中位图，第 i 位表示 keys[i] 是否命中，至少 (count + 63) / 64 个字，可为空
+     * @return 命中的数量
+     *
+     * 默认实现逐个调用 get；带锁的缓存会重写为整批只加一次锁。
+     */
+    virtual std::size_t getMany(const KeyType* keys, std::size_t count, ValueType* results,
+                                std::uint64_t* hitBits);
+
+    /**
+     * @brief 批量写入，按顺序依次写入 keys[i] = values[i]
+     */
+    virtual void putMany(const KeyType* keys, const ValueType* values, std::size_t count);
+
+    /**
+     * @brief 开启或关闭统计，应在并发访问开始之前调用；关闭后已有的计数保留
+     */
+    virtual void setStatsEnabled(bool enabled) { stats_.setEnabled(enabled); }
+
+    /**
+     * @brief 统计快照：计数来自各线程条带之和，size 与 weight 是读取时的值
+     *
+     * 各计数读取时没有统一加锁，并发写入期间得到的是近似值。
+     */
+    virtual CacheStats stats() const { return stats_.snapshot(); }
+
+    /**
+     * @brief 设置延迟记录器，为空时关闭记录；应在并发访问开始之前调用
+     *
+     * 同一个记录器可以由多个缓存共用，latency() 返回的是记录器中所有缓存的合计。
+     * 查询和写入的延迟包括等待锁的时间。
+     */
+    virtual void setLatencyRecorder(std::shared_ptr<LatencyRecorder> recorder)
+    {
+        latency_ = std::move(recorder);
+    }
+
+    // 使用本缓存独占的记录器开启或关闭延迟记录，关闭时丢弃已有的记录
+    void setLatencyEnabled(bool enabled)
+    {
+        setLatencyRecorder(enabled ? std::make_shared<LatencyRecorder>() : nullptr);
+    }
+
+    /**
+     * @brief 各操作的延迟直方图快照，未开启时为空
+     */
+    virtual LatencyReport latency() const
+    {
+        LatencyReport report;
+        if (latency_)
+            report = latency_->snapshot();
+        return report;
+    }
+
+  protected:
+    // 记录追踪事件，未开启 CACHE_TRACE 时整个调用被编译掉
+    void trace([[maybe_unused]] TraceOp op, [[maybe_unused]] std::size_t hash) const
+    {
+        if constexpr (kTraceEnabled)
+            Tracer::record(op, hash, traceShard_);
+    }
+
+    // 移除事件按原因记录，覆盖旧值记为 Update
+    void trace([[maybe_unused]] RemovalCause cause, [[maybe_unused]] std::size_t hash) const
+    {
+        if constexpr (kTraceEnabled)
+        {
+            static constexpr TraceOp ops[] = {
+                TraceOp::Evict, TraceOp::Expire, TraceOp::Update, TraceOp::Remove};
+            Tracer::record(ops[static_cast<int>(cause)], hash, traceShard_);
+        }
+    }
+
+    static void clearHitBits(std::uint64_t* hitBits, std::size_t count)
+    {
+        if (hitBits)
+            std::fill(hitBits, hitBits + (count + 63) / 64, 0);
+    }
+    static void setHitBit(std::uint64_t* hitBits, std::size_t index)
+    {
+        if (hitBits)
+            hitBits[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+};
+
+template <typename KeyType, typename ValueType>
+std::size_t BaseCache<KeyType, ValueType>::getMany(const KeyType* keys, std::size_t count,
+                                                   ValueType* results, std::uint64_t* hitBits)
+{
+    clearHitBits(hitBits, count);
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (get(keys[i], results[i]))
+        {
+            setHitBit(hitBits, i);
+            hits++;
+        }
+    }
+    return hits;
+}
+
+template <typename KeyType, typename ValueType>
+void BaseCache<KeyType, ValueType>::putMany(const KeyType* keys, const ValueType* values,
+                                            std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++) put(keys[i], values[i]);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 布隆过滤器，只记录键是否出现过（可能误判为出现过，不会漏判）
+ *
+ * 接口接收调用方算好的哈希值，由它派生出 kHashes 个比特位置。
+ */
+class BloomFilter
+{
+    static constexpr int kHashes = 3;
+
+    std::vector<std::uint64_t> bits_;
+    std::size_t                mask_; // 比特数量-1（比特数量为2的幂）
+
+  public:
+    /**
+     * @param bits 比特数量，会向上取整为2的幂，至少 64
+     */
+    explicit BloomFilter(std::size_t bits);
+
+    bool contains(std::size_t hash) const;
+
+    /**
+     * @brief 记录键
+     * @return 记录之前是否已经存在
+     */
+    bool put(std::size_t hash);
+
+    void clear() { std::fill(bits_.begin(), bits_.end(), 0); }
+
+  private:
+    // 第 i 个比特位置（双重哈希）
+    std::size_t bitAt(std::uint64_t mixed, int i) const
+    {
+        return static_cast<std::size_t>(mixed + i * ((mixed >> 29) | 1)) & mask_;
+    }
+
+    static std::uint64_t mix(std::uint64_t hash)
+    {
+        hash *= 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 31);
+    }
+};
+
+inline BloomFilter::BloomFilter(std::size_t bits)
+{
+    std::size_t count = 64;
+    while (count < bits) count *= 2;
+    mask_ = count - 1;
+    bits_.assign(count / 64, 0);
+}
+
+inline bool BloomFilter::contains(std::size_t hash) const
+{
+    std::uint64_t mixed = mix(hash);
+    for (int i = 0; i < kHashes; i++)
+    {
+        std::size_t bit = bitAt(mixed, i);
+        if (!(bits_[bit / 64] & (std::uint64_t{1} << (bit % 64))))
+            return false;
+    }
+    return true;
+}
+
+inline bool BloomFilter::put(std::size_t hash)
+{
+    std::uint64_t mixed   = mix(hash);
+    bool          present = true;
+    for (int i = 0; i < kHashes; i++)
+    {
+        std::size_t    bit  = bitAt(mixed, i);
+        std::uint64_t& word = bits_[bit / 64];
+        std::uint64_t  flag = std::uint64_t{1} << (bit % 64);
+        if (!(word & flag))
+        {
+            present = false;
+            word |= flag;
+        }
+    }
+    return present;
+}
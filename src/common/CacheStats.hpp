@@ -0,0 +1,170 @@
+#pragma once
+
+#include "RemovalListener.hpp"
+#include "ThreadStripe.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/**
+ * @brief 缓存统计快照，由 stats() 返回
+ */
+struct CacheStats
+{
+    std::uint64_t hits{};             // 命中次数
+    std::uint64_t misses{};           // 未命中次数
+    std::uint64_t puts{};             // 写入次数，包括更新和被拒绝的写入
+    std::uint64_t evictions{};        // 因容量被淘汰的条目数
+    std::uint64_t expirations{};      // 过期移除的条目数
+    std::uint64_t replacements{};     // 被新值覆盖的次数
+    std::uint64_t explicitRemovals{}; // 主动删除或清空的条目数
+    std::uint64_t ghostHits{};        // 命中幽灵记录的次数（ARC、2Q）
+    std::uint64_t promotions{};       // 访问次数达到 k 后进入缓存的次数（LRU-K）
+    std::size_t   size{};             // 当前条目数
+    std::int64_t  weight{};           // 当前总权重，未设置权重函数时等于 size
+
+    double hitRate() const
+    {
+        std::uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+
+    CacheStats& operator+=(const CacheStats& other)
+    {
+        hits += other.hits;
+        misses += other.misses;
+        puts += other.puts;
+        evictions += other.evictions;
+        expirations += other.expirations;
+        replacements += other.replacements;
+        explicitRemovals += other.explicitRemovals;
+        ghostHits += other.ghostHits;
+        promotions += other.promotions;
+        size += other.size;
+        weight += other.weight;
+        return *this;
+    }
+};
+
+/**
+ * @brief 按线程分条带的统计计数器
+ *
+ * 每个线程第一次计数时轮转分到一个条带，条带按 128 字节对齐（相邻缓存行预取也不会共享），
+ * 线程数不超过条带数时各线程只写自己的缓存行，没有跨核争用；读取时才把所有条带相加。
+ * 默认关闭，关闭时计数只是一次指针判空；条带在第一次开启时分配，之后一直保留。
+ */
+class StatsCounter
+{
+    enum Field
+    {
+        kHits,
+        kMisses,
+        kPuts,
+        kEvictions,
+        kExpirations,
+        kReplacements,
+        kExplicitRemovals,
+        kGhostHits,
+        kPromotions,
+        kFieldCount,
+    };
+
+    struct alignas(128) Stripe
+    {
+        std::atomic<std::uint64_t> counts[kFieldCount]{};
+    };
+
+    std::atomic<Stripe*> storage_{nullptr}; // 条带存储，第一次开启时分配，析构时释放
+    std::atomic<Stripe*> active_{nullptr};  // 开启时指向 storage_，关闭时为空
+    std::size_t          stripeMask_{};     // 条带数量-1（条带数量为2的幂）
+
+  public:
+    StatsCounter() = default;
+    ~StatsCounter() { delete[] storage_.load(std::memory_order_relaxed); }
+
+    StatsCounter(const StatsCounter&)            = delete;
+    StatsCounter& operator=(const StatsCounter&) = delete;
+
+    /**
+     * @brief 开启或关闭计数，不能与另一次 setEnabled 并发调用；关闭后已有的计数保留
+     */
+    void setEnabled(bool enabled)
+    {
+        Stripe* stripes = storage_.load(std::memory_order_relaxed);
+        if (enabled && !stripes)
+        {
+            std::size_t wanted = std::thread::hardware_concurrency();
+            std::size_t count  = 1;
+            while (count < wanted && count < 64) count <<= 1;
+            stripes     = new Stripe[count];
+            stripeMask_ = count - 1;
+            storage_.store(stripes, std::memory_order_release);
+        }
+        active_.store(enabled ? stripes : nullptr, std::memory_order_release);
+    }
+
+    bool enabled() const { return active_.load(std::memory_order_relaxed) != nullptr; }
+
+    void hit(std::uint64_t count = 1) { add(kHits, count); }
+    void miss(std::uint64_t count = 1) { add(kMisses, count); }
+    void put() { add(kPuts, 1); }
+    void ghostHit() { add(kGhostHits, 1); }
+    void promotion() { add(kPromotions, 1); }
+
+    void removal(RemovalCause cause)
+    {
+        switch (cause)
+        {
+        case RemovalCause::Size:
+            add(kEvictions, 1);
+            break;
+        case RemovalCause::Expired:
+            add(kExpirations, 1);
+            break;
+        case RemovalCause::Replaced:
+            add(kReplacements, 1);
+            break;
+        case RemovalCause::Explicit:
+            add(kExplicitRemovals, 1);
+            break;
+        }
+    }
+
+    /**
+     * @brief 汇总所有条带，size 与 weight 由缓存自己填写
+     */
+    CacheStats snapshot() const
+    {
+        CacheStats stats;
+        Stripe*    stripes = storage_.load(std::memory_order_acquire);
+        if (!stripes)
+            return stats;
+        std::uint64_t totals[kFieldCount]{};
+        for (std::size_t i = 0; i <= stripeMask_; i++)
+        {
+            for (int field = 0; field < kFieldCount; field++)
+                totals[field] += stripes[i].counts[field].load(std::memory_order_relaxed);
+        }
+        stats.hits             = totals[kHits];
+        stats.misses           = totals[kMisses];
+        stats.puts             = totals[kPuts];
+        stats.evictions        = totals[kEvictions];
+        stats.expirations      = totals[kExpirations];
+        stats.replacements     = totals[kReplacements];
+        stats.explicitRemovals = totals[kExplicitRemovals];
+        stats.ghostHits        = totals[kGhostHits];
+        stats.promotions       = totals[kPromotions];
+        return stats;
+    }
+
+  private:
+    void add(Field field, std::uint64_t count)
+    {
+        Stripe* stripes = active_.load(std::memory_order_acquire);
+        if (!stripes)
+            return;
+        stripes[threadStripe() & stripeMask_].counts[field].fetch_add(count,
+                                                                      std::memory_order_relaxed);
+    }
+};
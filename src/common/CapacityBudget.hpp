@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief 分片缓存的全局容量预算
+ *
+ * 总容量按分片数量精确均分（余数分给前几个分片），各分片容量之和恒等于总容量。
+ * 开启自适应后，预算记录每个分片的未命中次数，以及命中"幽灵指纹"的次数——
+ * 幽灵指纹是最近被淘汰键的哈希指纹，未命中的键恰好刚被淘汰，说明该分片容量不够。
+ * 周期性地从压力最小的分片收回一小份容量借给压力最大的分片，先缩后扩，总和从不超过总容量。
+ * 计数器和幽灵表均为无锁原子变量，可在分片锁内外调用；再平衡同一时刻只由一个线程执行。
+ */
+class CapacityBudget
+{
+    static constexpr std::uint32_t kRebalanceInterval = 1024;    // 分片每这么多次未命中尝试再平衡
+    static constexpr std::uint32_t kGhostWeight       = 8;       // 一次幽灵命中折算的未命中次数
+    static constexpr std::size_t   kMaxGhostSlots     = 1 << 20; // 幽灵表槽位上限
+
+    // 每个分片的压力计数器独占一个缓存行，避免不同分片的线程相互干扰
+    struct alignas(64) ShardState
+    {
+        std::atomic<std::uint32_t> misses{};    // 未命中次数
+        std::atomic<std::uint32_t> ghostHits{}; // 幽灵指纹命中次数
+        std::int64_t               share{};     // 当前分得的容量，只在持有 mutex_ 时修改
+    };
+
+    std::int64_t                                  total_;      // 总容量
+    int                                           shardCount_; // 分片数量
+    std::int64_t                                  floor_;      // 单个分片容量下限
+    std::int64_t                                  step_;       // 每次再平衡移动的容量
+    bool                                          adaptive_;   // 是否开启再平衡
+    std::unique_ptr<ShardState[]>                 shards_;     // 各分片状态
+    std::unique_ptr<std::atomic<std::uint32_t>[]> ghosts_;     // 幽灵指纹表，直接映射
+    unsigned                                      ghostShift_; // 由哈希计算幽灵表下标的右移位数
+    std::mutex                                    mutex_;      // 再平衡互斥
+
+  public:
+    /**
+     * @param total 总容量，按权重计容量时为总权重
+     * @param shards 期望的分片数量，会被限制在 [1, max(total, 1)] 内，保证每个分片至少一个位置
+     * @param adaptive 是否按分片压力再平衡容量
+     */
+    CapacityBudget(std::int64_t total, int shards, bool adaptive);
+
+    CapacityBudget(const CapacityBudget&)            = delete;
+    CapacityBudget& operator=(const CapacityBudget&) = delete;
+
+    int  shardCount() const { return shardCount_; }
+    bool adaptive() const { return adaptive_; }
+
+    /**
+     * @brief 分片的初始容量，用于构造分片
+     */
+    std::int64_t initialShare(int index) const;
+
+    /**
+     * @brief 记录被淘汰键的哈希，由分片在淘汰节点时调用
+     */
+    void recordEviction(std::size_t hash);
+
+    /**
+     * @brief 记录分片的一次未命中
+     * @return 是否到了尝试再平衡的时机
+     */
+    bool recordMiss(int index, std::size_t hash);
+
+    /**
+     * @brief 把一份容量从压力最小的分片移给压力最大的分片
+     * @param resize 回调 resize(index, delta)，调用方在其中修改分片容量；调用时不能持有分片锁
+     */
+    template <typename Resize>
+    void rebalance(Resize&& resize);
+
+  private:
+    static std::uint64_t mix(std::size_t hash)
+    {
+        return static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    }
+    // 指纹取混合值的低 32 位，最低位置 1 以区分空槽
+    static std::uint32_t fingerprint(std::uint64_t mixed)
+    {
+        return static_cast<std::uint32_t>(mixed) | 1u;
+    }
+};
+
+inline CapacityBudget::CapacityBudget(std::int64_t total, int shards, bool adaptive)
+    : total_(std::max<std::int64_t>(total, 0))
+    , shardCount_(static_cast<int>(
+          std::clamp<std::int64_t>(shards, 1, std::max<std::int64_t>(total_, 1))))
+    , adaptive_(adaptive)
+    , shards_(std::make_unique<ShardState[]>(shardCount_))
+    , ghostShift_(64)
+{
+    for (int i = 0; i < shardCount_; i++) shards_[i].share = initialShare(i);
+
+    // 每个分片最少保留平均份额的 1/4，每次移动平均份额的 1/32
+    std::int64_t average = total_ / shardCount_;
+    floor_               = std::max<std::int64_t>(average / 4, 1);
+    step_                = std::max<std::int64_t>(average / 32, 1);
+
+    if (adaptive_)
+    {
+        // 幽灵表槽位数取不小于总容量的 2 的幂，约能记住最近淘汰的一整个缓存的键；
+        // 按权重计容量时总容量可能是字节数，槽位数封顶
+        std::size_t slots = 16;
+        while (slots < kMaxGhostSlots && static_cast<std::int64_t>(slots) < total_) slots *= 2;
+        for (std::size_t n = slots; n > 1; n >>= 1) ghostShift_--;
+        ghosts_ = std::make_unique<std::atomic<std::uint32_t>[]>(slots);
+    }
+}
+
+inline std::int64_t CapacityBudget::initialShare(int index) const
+{
+    return total_ / shardCount_ + (index < total_ % shardCount_ ? 1 : 0);
+}
+
+inline void CapacityBudget::recordEviction(std::size_t hash)
+{
+    if (!adaptive_)
+        return;
+    std::uint64_t mixed = mix(hash);
+    ghosts_[mixed >> ghostShift_].store(fingerprint(mixed), std::memory_order_relaxed);
+}
+
+inline bool CapacityBudget::recordMiss(int index, std::size_t hash)
+{
+    if (!adaptive_)
+        return false;
+
+    ShardState&                 shard = shards_[index];
+    std::uint64_t               mixed = mix(hash);
+    std::atomic<std::uint32_t>& ghost = ghosts_[mixed >> ghostShift_];
+    if (ghost.load(std::memory_order_relaxed) == fingerprint(mixed))
+    {
+        // 每个幽灵只计一次
+        ghost.store(0, std::memory_order_relaxed);
+        shard.ghostHits.fetch_add(1, std::memory_order_relaxed);
+    }
+    return (shard.misses.fetch_add(1, std::memory_order_relaxed) + 1) % kRebalanceInterval == 0;
+}
+
+template <typename Resize>
+void CapacityBudget::rebalance(Resize&& resize)
+{
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    int           receiver      = -1;
+    int           donor         = -1;
+    std::uint64_t receiverScore = 0;
+    std::uint64_t donorScore    = 0;
+    std::uint32_t receiverGhost = 0;
+    std::uint32_t donorGhost    = 0;
+    for (int i = 0; i < shardCount_; i++)
+    {
+        ShardState&   shard  = shards_[i];
+        std::uint32_t misses = shard.misses.load(std::memory_order_relaxed);
+        std::uint32_t ghosts = shard.ghostHits.load(std::memory_order_relaxed);
+        std::uint64_t score  = misses + std::uint64_t{kGhostWeight} * ghosts;
+        if (receiver < 0 || score > receiverScore)
+        {
+            receiver      = i;
+            receiverScore = score;
+            receiverGhost = ghosts;
+        }
+        if (shard.share - step_ >= floor_ && (donor < 0 || score < donorScore))
+        {
+            donor      = i;
+            donorScore = score;
+            donorGhost = ghosts;
+        }
+
+        // 计数器减半，使压力随时间衰减，反映最近的访问分布
+        shard.misses.store(misses / 2, std::memory_order_relaxed);
+        shard.ghostHits.store(ghosts / 2, std::memory_order_relaxed);
+    }
+
+    // 只有接收方确实在丢失刚淘汰的键、且压力明显高于捐出方时才移动
+    if (donor < 0 || donor == receiver || receiverGhost <= donorGhost ||
+        receiverScore <= 2 * donorScore)
+        return;
+
+    // 先缩小捐出方再扩大接收方，任意时刻各分片容量之和都不超过总容量
+    resize(donor, -step_);
+    shards_[donor].share -= step_;
+    resize(receiver, step_);
+    shards_[receiver].share += step_;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+/**
+ * @brief 粗粒度时钟：后台线程每毫秒刷新一次时间戳，读取只是一次原子加载
+ *
+ * 过期判断在每次查找时都会发生，直接调用 steady_clock::now 的开销与查找本身相当。
+ * 时间戳单位为毫秒，误差不超过一个刷新周期；后台线程在第一次读取时启动，程序退出时停止。
+ */
+class CoarseClock
+{
+    std::atomic<std::int64_t> now_;    // 最近一次刷新的时间戳
+    std::atomic<bool>         stop_{}; // 通知后台线程退出
+    std::thread               ticker_; // 刷新线程，最后构造
+
+  public:
+    static constexpr std::chrono::milliseconds kResolution{1}; // 刷新周期
+
+    // 粗粒度的当前时间（毫秒），始终大于 0
+    static std::int64_t now() { return instance().now_.load(std::memory_order_relaxed); }
+
+    // 精确的当前时间（毫秒），与 now 同一时间基准
+    static std::int64_t preciseNow()
+    {
+        auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() + 1;
+    }
+
+    CoarseClock(const CoarseClock&)            = delete;
+    CoarseClock& operator=(const CoarseClock&) = delete;
+
+  private:
+    CoarseClock() : now_(preciseNow()), ticker_([this] { run(); }) {}
+
+    ~CoarseClock()
+    {
+        stop_.store(true, std::memory_order_relaxed);
+        ticker_.join();
+    }
+
+    static CoarseClock& instance()
+    {
+        static CoarseClock clock;
+        return clock;
+    }
+
+    void run()
+    {
+        while (!stop_.load(std::memory_order_relaxed))
+        {
+            std::this_thread::sleep_for(kResolution);
+            now_.store(preciseNow(), std::memory_order_relaxed);
+        }
+    }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Hash.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 4 位计数器的 Count-Min Sketch，用于估计键的访问频次
+ *
+ * 共 4 行，每行 width 个计数器，16 个计数器打包在一个 uint64_t 中，计数器上限为 15。
+ * 估计值取 4 行中的最小值；halve 把所有计数器减半，由调用方周期性调用使频次随时间衰减。
+ * 接口接收调用方算好的哈希值，内部再做一次混合，弱哈希（如整数恒等哈希）也能均匀分布。
+ */
+class CountMinSketch
+{
+    static constexpr int kDepth = 4;
+
+    std::vector<std::uint64_t> table_;    // kDepth 行计数器
+    std::size_t                rowWords_; // 每行占用的 uint64_t 数量
+    std::size_t                mask_;     // 每行计数器数量-1（计数器数量为2的幂）
+
+  public:
+    /**
+     * @param width 每行计数器数量，会向上取整为2的幂，至少 16
+     */
+    explicit CountMinSketch(std::size_t width);
+
+    /**
+     * @brief 键的频次加一，已达上限的计数器保持不变
+     */
+    void increment(std::size_t hash);
+
+    /**
+     * @brief 估计键的频次（0~15）
+     */
+    int estimate(std::size_t hash) const;
+
+    /**
+     * @brief 所有计数器减半
+     */
+    void halve();
+
+    void clear() { std::fill(table_.begin(), table_.end(), 0); }
+
+  private:
+    // 第 row 行中计数器的下标（双重哈希）
+    static std::size_t column(std::uint64_t mixed, int row)
+    {
+        return static_cast<std::size_t>(mixed + row * ((mixed >> 32) | 1));
+    }
+};
+
+inline CountMinSketch::CountMinSketch(std::size_t width)
+{
+    std::size_t columns = 16;
+    while (columns < width) columns *= 2;
+    mask_     = columns - 1;
+    rowWords_ = columns / 16;
+    table_.assign(rowWords_ * kDepth, 0);
+}
+
+inline void CountMinSketch::increment(std::size_t hash)
+{
+    std::uint64_t mixed = mixHash(hash);
+    for (int row = 0; row < kDepth; row++)
+    {
+        std::size_t    index = column(mixed, row) & mask_;
+        std::uint64_t& word  = table_[row * rowWords_ + index / 16];
+        unsigned       shift = (index % 16) * 4;
+        if (((word >> shift) & 0xF) != 0xF)
+            word += std::uint64_t{1} << shift;
+    }
+}
+
+inline int CountMinSketch::estimate(std::size_t hash) const
+{
+    std::uint64_t mixed = mixHash(hash);
+    int           freq  = 0xF;
+    for (int row = 0; row < kDepth; row++)
+    {
+        std::size_t   index = column(mixed, row) & mask_;
+        std::uint64_t word  = table_[row * rowWords_ + index / 16];
+        freq                = std::min(freq, static_cast<int>((word >> ((index % 16) * 4)) & 0xF));
+    }
+    return freq;
+}
+
+inline void CountMinSketch::halve()
+{
+    // 每个 4 位计数器右移一位，清掉从相邻计数器移入的最高位
+    for (auto& word : table_) word = (word >> 1) & 0x7777777777777777ull;
+}
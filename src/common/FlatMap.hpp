@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Hash.hpp"
+#include "Prefetch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief FlatMap 的默认取键方式：槽位自己保存一份键
+ */
+struct StoredKey
+{
+};
+
+/**
+ * @brief 从节点指针取键，值本身就是节点的索引（如 key->node）用它避免在槽位中再存一份键
+ */
+struct NodeKey
+{
+    template <typename NodePtr>
+    const auto& operator()(NodePtr node) const
+    {
+        return node->key;
+    }
+};
+
+/**
+ * @brief 开放寻址哈希表（Robin Hood 探测 + 回移删除）
+ *
+ * 所有槽位存放在一块连续内存中，每个槽位缓存完整哈希值，比较键之前先比较哈希。
+ * 调用方可以先用 hashOf 计算一次哈希，再把它传给 find/insert/erase，避免重复哈希。
+ * 查找类接口接受任意能被 Hasher/KeyEqual 处理的键类型（异构查找）。
+ *
+ * KeyOf 为 StoredKey 时槽位保存 {哈希, 距离, 键, 值}；否则为取键模式，槽位只保存 {哈希, 距离, 值}，
+ * 比较时用 keyOf(值) 取得键，键只存放在值指向的节点中。取键模式下节点的键在条目被 erase 之前
+ * 不能修改或移走。
+ * 注意：insert/erase 可能移动槽位，之前 find 得到的指针随之失效。
+ */
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>,
+          typename KeyEqual = std::equal_to<>, typename KeyOf = StoredKey>
+class FlatMap
+{
+    static constexpr bool kStoresKey = std::is_same_v<KeyOf, StoredKey>;
+
+    struct KeySlot
+    {
+        std::size_t   hash{}; // 缓存的哈希值
+        std::uint32_t dist{}; // 与理想位置的距离+1，0表示空槽
+        KeyType       key{};
+        ValueType     value{};
+    };
+
+    struct ValueSlot
+    {
+        std::size_t   hash{};
+        std::uint32_t dist{};
+        ValueType     value{}; // 键由 keyOf(value) 取得
+    };
+
+    using Slot = std::conditional_t<kStoresKey, KeySlot, ValueSlot>;
+
+    std::vector<Slot> slots_;
+    std::size_t       mask_{};
+    std::size_t       size_{};
+    unsigned          shift_{64}; // 由哈希值计算理想位置时的右移位数
+    Hasher            hasher_;
+    KeyEqual          equal_;
+    KeyOf             keyOf_;
+
+  public:
+    FlatMap() = default;
+    explicit FlatMap(std::size_t expected, KeyOf keyOf = KeyOf{}) : keyOf_(std::move(keyOf))
+    {
+        reserve(expected);
+    }
+
+    template <typename K>
+    std::size_t hashOf(const K& key) const
+    {
+        return hasher_(key);
+    }
+
+    template <typename K>
+    ValueType* find(const K& key)
+    {
+        return find(key, hashOf(key));
+    }
+    template <typename K>
+    const ValueType* find(const K& key) const
+    {
+        return find(key, hashOf(key));
+    }
+    template <typename K>
+    ValueType* find(const K& key, std::size_t hash);
+    template <typename K>
+    const ValueType* find(const K& key, std::size_t hash) const;
+
+    template <typename K>
+    bool contains(const K& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief 预取哈希值对应的理想槽位，随后对同一哈希的 find 大概率不再等待内存
+     */
+    void prefetch(std::size_t hash) const
+    {
+        if (!slots_.empty())
+            prefetchRead(&slots_[home(hash)]);
+    }
+
+    /**
+     * @brief 插入键值，若键已存在则不覆盖（保存键的模式）
+     * @return 指向表中值的指针，以及是否发生了插入
+     */
+    template <bool StoresKey = kStoresKey, typename = std::enable_if_t<StoresKey>>
+    std::pair<ValueType*, bool> insert(const KeyType& key, ValueType value)
+    {
+        return insert(hashOf(key), key, std::move(value));
+    }
+    template <bool StoresKey = kStoresKey, typename = std::enable_if_t<StoresKey>>
+    std::pair<ValueType*, bool> insert(std::size_t hash, KeyType key, ValueType value)
+    {
+        if (ValueType* found = find(key, hash))
+            return {found, false};
+        return {place(Slot{hash, 1, std::move(key), std::move(value)}), true};
+    }
+
+    /**
+     * @brief 插入值，键为 keyOf(value)，若键已存在则不覆盖（取键模式）
+     * @param hash keyOf(value) 的哈希
+     */
+    template <bool StoresKey = kStoresKey, typename = std::enable_if_t<!StoresKey>>
+    std::pair<ValueType*, bool> insert(std::size_t hash, ValueType value)
+    {
+        if (ValueType* found = find(keyOf_(value), hash))
+            return {found, false};
+        return {place(Slot{hash, 1, std::move(value)}), true};
+    }
+
+    /**
+     * @brief 取得键对应的值，不存在时插入默认值（保存键的模式）
+     */
+    template <bool StoresKey = kStoresKey, typename = std::enable_if_t<StoresKey>>
+    ValueType& operator[](const KeyType& key)
+    {
+        return *insert(key, ValueType{}).first;
+    }
+
+    template <typename K>
+    bool erase(const K& key)
+    {
+        return erase(key, hashOf(key));
+    }
+    template <typename K>
+    bool erase(const K& key, std::size_t hash);
+
+    std::size_t size() const { return size_; }
+    bool        empty() const { return size_ == 0; }
+    void        clear();
+    void        reserve(std::size_t expected);
+
+    /**
+     * @brief 遍历所有键值，回调签名为 fn(const KeyType&, ValueType&)
+     */
+    template <typename Func>
+    void forEach(Func&& fn);
+
+  private:
+    std::size_t home(std::size_t hash) const
+    {
+        // 斐波那契散列，取高位，弱哈希（如整数恒等哈希）也能均匀分布
+        return static_cast<std::size_t>(
+            (static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+    const KeyType& keyOf(const Slot& slot) const
+    {
+        if constexpr (kStoresKey)
+            return slot.key;
+        else
+            return keyOf_(slot.value);
+    }
+    // 放入一个确定不在表中的元素，返回它在表中的位置
+    ValueType* place(Slot carry);
+    void       rehash(std::size_t newCapacity);
+};
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+template <typename K>
+ValueType* FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::find(const K&    key,
+                                                                       std::size_t hash)
+{
+    const auto* self = this;
+    return const_cast<ValueType*>(self->find(key, hash));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+template <typename K>
+const ValueType*
+FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::find(const K& key, std::size_t hash) const
+{
+    if (size_ == 0)
+        return nullptr;
+
+    std::size_t   pos  = home(hash);
+    std::uint32_t dist = 1;
+    while (true)
+    {
+        const Slot& slot = slots_[pos];
+        // 遇到空槽或探测距离更短的槽，说明键不存在（Robin Hood 不变式）
+        if (slot.dist < dist)
+            return nullptr;
+        if (slot.hash == hash && equal_(keyOf(slot), key))
+            return &slot.value;
+        pos = (pos + 1) & mask_;
+        dist++;
+    }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+ValueType* FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::place(Slot carry)
+{
+    // 负载因子上限 7/8
+    if ((size_ + 1) * 8 > slots_.size() * 7)
+        rehash(slots_.empty() ? 16 : slots_.size() * 2);
+
+    // 新元素落在第一个空槽或探测距离更短的槽，被挤出的元素继续向后探测
+    ValueType*  inserted = nullptr;
+    std::size_t pos      = home(carry.hash);
+    carry.dist           = 1;
+    while (true)
+    {
+        Slot& slot = slots_[pos];
+        if (slot.dist == 0)
+        {
+            slot = std::move(carry);
+            break;
+        }
+        if (slot.dist < carry.dist)
+        {
+            std::swap(slot, carry);
+            if (!inserted)
+                inserted = &slot.value;
+        }
+        pos = (pos + 1) & mask_;
+        carry.dist++;
+    }
+
+    size_++;
+    return inserted ? inserted : &slots_[pos].value;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+template <typename K>
+bool FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::erase(const K& key, std::size_t hash)
+{
+    if (size_ == 0)
+        return false;
+
+    std::size_t   pos  = home(hash);
+    std::uint32_t dist = 1;
+    while (true)
+    {
+        Slot& slot = slots_[pos];
+        if (slot.dist < dist)
+            return false;
+        if (slot.hash == hash && equal_(keyOf(slot), key))
+            break;
+        pos = (pos + 1) & mask_;
+        dist++;
+    }
+
+    // 回移删除：把后续不在理想位置的元素依次前移一格
+    std::size_t next = (pos + 1) & mask_;
+    while (slots_[next].dist > 1)
+    {
+        slots_[pos] = std::move(slots_[next]);
+        slots_[pos].dist--;
+        pos  = next;
+        next = (next + 1) & mask_;
+    }
+    slots_[pos] = Slot{};
+
+    size_--;
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+void FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::clear()
+{
+    for (auto& slot : slots_) slot = Slot{};
+    size_ = 0;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+void FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::reserve(std::size_t expected)
+{
+    std::size_t capacity = 16;
+    while (capacity * 7 < expected * 8) capacity *= 2;
+    if (capacity > slots_.size())
+        rehash(capacity);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+template <typename Func>
+void FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::forEach(Func&& fn)
+{
+    for (auto& slot : slots_)
+    {
+        if (slot.dist != 0)
+            fn(keyOf(slot), slot.value);
+    }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher, typename KeyEqual,
+          typename KeyOf>
+void FlatMap<KeyType, ValueType, Hasher, KeyEqual, KeyOf>::rehash(std::size_t newCapacity)
+{
+    std::vector<Slot> old(newCapacity);
+    old.swap(slots_);
+    mask_  = newCapacity - 1;
+    shift_ = 64;
+    for (std::size_t n = newCapacity; n > 1; n >>= 1) shift_--;
+    size_ = 0;
+
+    for (auto& slot : old)
+    {
+        if (slot.dist != 0)
+            place(std::move(slot));
+    }
+}
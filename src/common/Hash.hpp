@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief MurmurHash3 的 fmix64 终结器，把输入的每一位扩散到输出的所有位
+ */
+inline std::uint64_t mixHash(std::uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+namespace hash_detail
+{
+    // 64x64->128 位乘法，结果的低、高 64 位分别写回 a、b
+    inline void multiply(std::uint64_t& a, std::uint64_t& b)
+    {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        a                   = static_cast<std::uint64_t>(product);
+        b                   = static_cast<std::uint64_t>(product >> 64);
+#else
+        // 没有 128 位整数的平台按 32 位拆分
+        std::uint64_t aHigh = a >> 32;
+        std::uint64_t aLow  = static_cast<std::uint32_t>(a);
+        std::uint64_t bHigh = b >> 32;
+        std::uint64_t bLow  = static_cast<std::uint32_t>(b);
+        std::uint64_t high  = aHigh * bHigh;
+        std::uint64_t mid0  = aHigh * bLow;
+        std::uint64_t mid1  = aLow * bHigh;
+        std::uint64_t low   = aLow * bLow;
+        std::uint64_t t     = low + (mid0 << 32);
+        std::uint64_t lo    = t + (mid1 << 32);
+        std::uint64_t carry = (t < low) + (lo < t);
+        a                   = lo;
+        b                   = high + (mid0 >> 32) + (mid1 >> 32) + carry;
+#endif
+    }
+
+    inline std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+    {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+    inline std::uint64_t read64(const unsigned char* p)
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline std::uint64_t read32(const unsigned char* p)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    constexpr std::uint64_t kSecret[4] = {0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull,
+                                          0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull};
+} // namespace hash_detail
+
+/**
+ * @brief 字节串哈希（wyhash 算法）
+ *
+ * 每次乘法消化 16 字节，长串按 48 字节一轮、三路并行处理，比逐字节的 std::hash 快得多；
+ * 不超过 16 字节的短串只需读取几次、做两次乘法。按小端序读取内存。
+ */
+inline std::uint64_t hashBytes(const void* data, std::size_t length, std::uint64_t seed = 0)
+{
+    using namespace hash_detail;
+
+    const auto*   p = static_cast<const unsigned char*>(data);
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    seed ^= mix(seed ^ kSecret[0], kSecret[1]);
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            // 首尾各读两个 4 字节，覆盖 4~16 字节的全部内容
+            std::size_t quarter = (length >> 3) << 2;
+            a                   = (read32(p) << 32) | read32(p + quarter);
+            b                   = (read32(p + length - 4) << 32) | read32(p + length - 4 - quarter);
+        }
+        else if (length > 0)
+        {
+            a = (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[length >> 1]} << 8) | p[length - 1];
+        }
+    }
+    else
+    {
+        std::size_t remaining = length;
+        if (remaining > 48)
+        {
+            std::uint64_t seed1 = seed;
+            std::uint64_t seed2 = seed;
+            do
+            {
+                seed  = mix(read64(p) ^ kSecret[1], read64(p + 8) ^ seed);
+                seed1 = mix(read64(p + 16) ^ kSecret[2], read64(p + 24) ^ seed1);
+                seed2 = mix(read64(p + 32) ^ kSecret[3], read64(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16)
+        {
+            seed = mix(read64(p) ^ kSecret[1], read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // 最后 16 字节可能与已处理的部分重叠，长度在最终混合时计入
+        a = read64(p + remaining - 16);
+        b = read64(p + remaining - 8);
+    }
+    a ^= kSecret[1];
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ kSecret[0] ^ length, b ^ kSecret[1]);
+}
+
+/**
+ * @brief 缓存默认使用的哈希函数
+ *
+ * 整数等类型在 std::hash 的结果上再做 fmix64 混合：std::hash<int> 通常是恒等映射，
+ * 连续的键会落在可预测的分片和槽位上，混合后高位、低位都均匀分布。
+ * std::string 的特化使用 hashBytes，并且是透明的：可以直接用 std::string_view / const char* 查找，
+ * 无需构造临时字符串。
+ *
+ * 自定义 Hasher 需要保证结果的高位也均匀分布，分片缓存按哈希高位选择分片（见 sliceOf）。
+ */
+template <typename KeyType>
+struct DefaultHash
+{
+    std::size_t operator()(const KeyType& key) const
+    {
+        return static_cast<std::size_t>(mixHash(std::hash<KeyType>{}(key)));
+    }
+};
+
+template <>
+struct DefaultHash<std::string>
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const
+    {
+        return static_cast<std::size_t>(hashBytes(key.data(), key.size()));
+    }
+};
+
+/**
+ * @brief 把哈希值映射到 [0, count)（Lemire 快速区间映射），用乘法和移位代替取模
+ *
+ * 只使用哈希的高 32 位；FlatMap 对完整哈希再做乘法散列取槽位，同一分片的键在分片索引中仍均匀分布。
+ */
+inline std::size_t sliceOf(std::size_t hash, std::size_t count)
+{
+    std::uint64_t high = sizeof(std::size_t) >= 8 ? static_cast<std::uint64_t>(hash) >> 32
+                                                  : static_cast<std::uint32_t>(hash);
+    return static_cast<std::size_t>((high * count) >> 32);
+}
+
+template <typename Hasher, typename = void>
+struct IsTransparentHash : std::false_type
+{
+};
+
+template <typename Hasher>
+struct IsTransparentHash<Hasher, std::void_t<typename Hasher::is_transparent>> : std::true_type
+{
+};
+
+// K 是否可以作为 KeyType 的异构查找键（如 std::string 缓存使用 std::string_view 查找）
+template <typename KeyType, typename K, typename Hasher = DefaultHash<KeyType>>
+inline constexpr bool IsHeterogeneousKey =
+    !std::is_same_v<std::decay_t<K>, KeyType> && IsTransparentHash<Hasher>::value &&
+    std::is_invocable_r_v<std::size_t, const Hasher&, const K&>;
@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @brief 侵入式双向链表，头部为最近访问
+ *
+ * 节点类型需要有 prev/next 指针字段，且可以默认构造（用作内联哨兵）。
+ * 链表不拥有节点，节点的分配和回收由调用方（通常是 NodePool）负责。
+ */
+template <typename NodeType>
+class IntrusiveList
+{
+    NodeType head_; // 虚拟头节点
+    NodeType tail_; // 虚拟尾节点
+    int      size_{};
+
+  public:
+    IntrusiveList()
+    {
+        head_.next = &tail_;
+        tail_.prev = &head_;
+    }
+
+    IntrusiveList(const IntrusiveList&)            = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    void pushFront(NodeType* node)
+    {
+        node->next       = head_.next;
+        node->prev       = &head_;
+        head_.next->prev = node;
+        head_.next       = node;
+        size_++;
+    }
+
+    void unlink(NodeType* node)
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        node->prev       = nullptr;
+        node->next       = nullptr;
+        size_--;
+    }
+
+    void moveToFront(NodeType* node)
+    {
+        unlink(node);
+        pushFront(node);
+    }
+
+    // 最久未访问的节点，链表为空时返回 nullptr
+    NodeType* back() const { return size_ > 0 ? tail_.prev : nullptr; }
+
+    int  size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+};
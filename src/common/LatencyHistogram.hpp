@@ -0,0 +1,269 @@
+#pragma once
+
+#include "ThreadStripe.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 记录延迟的操作类型
+ */
+enum class LatencyOp
+{
+    GetHit,      // 命中的查询
+    GetMiss,     // 未命中的查询
+    Put,         // 写入，包括写入引起的淘汰
+    Evict,       // 淘汰单个条目
+    Maintenance, // 频次衰减、时间轮推进、读缓冲回放、分片再平衡等维护操作
+    Load,        // getOrLoad 的加载，包括等待其他线程的同一次加载
+};
+
+inline constexpr int kLatencyOpCount = 6;
+
+inline const char* latencyOpName(LatencyOp op)
+{
+    static const char* const names[kLatencyOpCount] = {
+        "get hit", "get miss", "put", "evict", "maintenance", "load"};
+    return names[static_cast<int>(op)];
+}
+
+/**
+ * @brief HDR 风格的对数分桶直方图（单位纳秒），非线程安全，用作快照和合并的结果
+ *
+ * 小于 16 的值各占一个桶，之后每个 2 的幂区间再等分为 16 个桶，相对误差不超过 1/16；
+ * 超过约 68 秒的值计入最后一个桶，最大值单独精确记录。
+ */
+class LatencyHistogram
+{
+  public:
+    static constexpr int          kSubBits     = 4;
+    static constexpr int          kSubCount    = 1 << kSubBits;
+    static constexpr int          kMaxExponent = 36; // 可分辨的上限为 2^36 纳秒
+    static constexpr int          kBucketCount = (kMaxExponent - kSubBits + 1) * kSubCount;
+    static constexpr std::int64_t kMaxValue    = (std::int64_t{1} << kMaxExponent) - 1;
+
+  private:
+    std::vector<std::uint64_t> counts_; // 各桶的记录数
+    std::uint64_t              count_{}; // 总记录数
+    std::uint64_t              sum_{};   // 总耗时，用于平均值
+    std::int64_t               max_{};   // 精确的最大值
+
+  public:
+    LatencyHistogram() : counts_(kBucketCount) {}
+
+    static int bucketOf(std::int64_t value)
+    {
+        value = std::clamp<std::int64_t>(value, 0, kMaxValue);
+        if (value < kSubCount)
+            return static_cast<int>(value);
+        int exponent = 63 - __builtin_clzll(static_cast<unsigned long long>(value));
+        int shift    = exponent - kSubBits;
+        return (shift + 1) * kSubCount + static_cast<int>((value >> shift) & (kSubCount - 1));
+    }
+
+    // 桶内可能的最大值，百分位按它报告，不会低估延迟
+    static std::int64_t bucketUpper(int bucket)
+    {
+        if (bucket < kSubCount)
+            return bucket;
+        int          shift = bucket / kSubCount - 1;
+        std::int64_t lower = static_cast<std::int64_t>(kSubCount + bucket % kSubCount) << shift;
+        return lower + (std::int64_t{1} << shift) - 1;
+    }
+
+    void record(std::int64_t nanos)
+    {
+        nanos = std::max<std::int64_t>(nanos, 0);
+        addBucket(bucketOf(nanos), 1);
+        addTotals(static_cast<std::uint64_t>(nanos), nanos);
+    }
+
+    // 供合并使用：直接累加某个桶的计数，总和与最大值由 addTotals 单独累加
+    void addBucket(int bucket, std::uint64_t count)
+    {
+        counts_[bucket] += count;
+        count_ += count;
+    }
+
+    void addTotals(std::uint64_t sum, std::int64_t max)
+    {
+        sum_ += sum;
+        max_ = std::max(max_, max);
+    }
+
+    LatencyHistogram& operator+=(const LatencyHistogram& other)
+    {
+        for (int i = 0; i < kBucketCount; i++) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+        return *this;
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::int64_t  max() const { return max_; }
+    double        mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    /**
+     * @brief 百分位延迟（纳秒），quantile 取 [0, 1]，如 0.999 为 p99.9；没有记录时返回 0
+     */
+    std::int64_t percentile(double quantile) const
+    {
+        if (count_ == 0)
+            return 0;
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(quantile * count_));
+        std::uint64_t seen = 0;
+        rank               = std::clamp<std::uint64_t>(rank, 1, count_);
+        for (int i = 0; i < kBucketCount; i++)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+                return std::min(bucketUpper(i), max_);
+        }
+        return max_;
+    }
+};
+
+/**
+ * @brief 每种操作一个直方图
+ */
+struct LatencyReport
+{
+    LatencyHistogram ops[kLatencyOpCount];
+
+    LatencyHistogram&       operator[](LatencyOp op) { return ops[static_cast<int>(op)]; }
+    const LatencyHistogram& operator[](LatencyOp op) const { return ops[static_cast<int>(op)]; }
+
+    LatencyReport& operator+=(const LatencyReport& other)
+    {
+        for (int i = 0; i < kLatencyOpCount; i++) ops[i] += other.ops[i];
+        return *this;
+    }
+};
+
+/**
+ * @brief 多线程延迟记录器
+ *
+ * 每个线程第一次记录时轮转分到一个条带，条带在第一次被使用时才分配，内存只随实际记录的线程数
+ * 增长。记录只是对本线程条带的几次 relaxed 原子加，线程之间不共享缓存行；读取时无锁地把各条带
+ * 合并成 LatencyReport，与记录并发时得到的是近似快照。
+ */
+class LatencyRecorder
+{
+    static constexpr int kMaxStripes = 64;
+
+    struct alignas(128) Stripe
+    {
+        std::atomic<std::uint64_t> counts[kLatencyOpCount][LatencyHistogram::kBucketCount]{};
+        std::atomic<std::uint64_t> sums[kLatencyOpCount]{};
+        std::atomic<std::int64_t>  maxes[kLatencyOpCount]{};
+    };
+
+    std::atomic<Stripe*> stripes_[kMaxStripes]{}; // 按线程轮转分配的条带，第一次使用时创建
+
+  public:
+    LatencyRecorder() = default;
+    ~LatencyRecorder()
+    {
+        for (auto& stripe : stripes_) delete stripe.load(std::memory_order_relaxed);
+    }
+
+    LatencyRecorder(const LatencyRecorder&)            = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    void record(LatencyOp op, std::int64_t nanos)
+    {
+        Stripe& stripe = localStripe();
+        int     index  = static_cast<int>(op);
+        nanos          = std::max<std::int64_t>(nanos, 0);
+        stripe.counts[index][LatencyHistogram::bucketOf(nanos)].fetch_add(
+            1, std::memory_order_relaxed);
+        stripe.sums[index].fetch_add(static_cast<std::uint64_t>(nanos), std::memory_order_relaxed);
+        std::atomic<std::int64_t>& max     = stripe.maxes[index];
+        std::int64_t               current = max.load(std::memory_order_relaxed);
+        while (nanos > current &&
+               !max.compare_exchange_weak(current, nanos, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    LatencyReport snapshot() const
+    {
+        LatencyReport report;
+        for (const auto& slot : stripes_)
+        {
+            const Stripe* stripe = slot.load(std::memory_order_acquire);
+            if (!stripe)
+                continue;
+            for (int op = 0; op < kLatencyOpCount; op++)
+            {
+                LatencyHistogram& histogram = report.ops[op];
+                const auto&       counts    = stripe->counts[op];
+                for (int bucket = 0; bucket < LatencyHistogram::kBucketCount; bucket++)
+                {
+                    std::uint64_t count = counts[bucket].load(std::memory_order_relaxed);
+                    if (count)
+                        histogram.addBucket(bucket, count);
+                }
+                histogram.addTotals(stripe->sums[op].load(std::memory_order_relaxed),
+                                    stripe->maxes[op].load(std::memory_order_relaxed));
+            }
+        }
+        return report;
+    }
+
+  private:
+    Stripe& localStripe()
+    {
+        std::atomic<Stripe*>& slot   = stripes_[threadStripe() & (kMaxStripes - 1)];
+        Stripe*               stripe = slot.load(std::memory_order_acquire);
+        if (stripe)
+            return *stripe;
+        // 共用同一条带的线程可能同时创建，只保留先写入的一个
+        Stripe* created = new Stripe;
+        if (slot.compare_exchange_strong(stripe, created, std::memory_order_acq_rel))
+            return *created;
+        delete created;
+        return *stripe;
+    }
+};
+
+/**
+ * @brief 作用域计时：recorder 为空时不读取时钟，析构时按当前的操作类型记录
+ */
+class LatencyScope
+{
+    using Clock = std::chrono::steady_clock;
+
+    LatencyRecorder*  recorder_;
+    LatencyOp         op_;
+    Clock::time_point start_{};
+
+  public:
+    LatencyScope(LatencyRecorder* recorder, LatencyOp op) : recorder_(recorder), op_(op)
+    {
+        if (recorder_)
+            start_ = Clock::now();
+    }
+
+    ~LatencyScope()
+    {
+        if (recorder_)
+            recorder_->record(
+                op_, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_)
+                         .count());
+    }
+
+    LatencyScope(const LatencyScope&)            = delete;
+    LatencyScope& operator=(const LatencyScope&) = delete;
+
+    // 结果确定后修改记录的操作类型，如查询在命中时改为 GetHit
+    void setOp(LatencyOp op) { op_ = op; }
+
+    // 本次操作无需记录，如时间轮推进时没有过期的节点
+    void dismiss() { recorder_ = nullptr; }
+};
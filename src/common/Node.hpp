@@ -1,19 +1,27 @@
 #pragma once
 
-#include <memory>
+#include <cstddef>
 
+// 链表节点：只有键、值、哈希和链表指针，过期时间等附加信息见 NodeMeta，LFU 使用 FreqNode
 template <typename KeyType, typename ValueType>
 struct Node
 {
-    KeyType                                   key;
-    ValueType                                 value;
-    int                                       freq{1}; // LFU需要的频次字段，LRU可以忽略
-    std::weak_ptr<Node<KeyType, ValueType>>   prev;    // 使用weak_ptr避免循环引用
-    std::shared_ptr<Node<KeyType, ValueType>> next;
+    KeyType                   key;
+    ValueType                 value;
+    std::size_t               hash{};        // 索引中缓存的哈希值，删除时无需重新计算
+    Node<KeyType, ValueType>* prev{nullptr}; // 节点由NodePool持有，链表只使用原始指针
+    Node<KeyType, ValueType>* next{nullptr};
 
     Node() = default;
     Node(const KeyType& key, const ValueType& value) : key(key), value(value) {}
-    Node(const KeyType& key, const ValueType& value, int freq) : key(key), value(value), freq(freq)
-    {
-    }
+};
+
+// 幽灵记录：只保存键和哈希值，用于记住最近被淘汰的键
+template <typename KeyType>
+struct GhostNode
+{
+    KeyType             key{};
+    std::size_t         hash{};
+    GhostNode<KeyType>* prev{nullptr};
+    GhostNode<KeyType>* next{nullptr};
 };
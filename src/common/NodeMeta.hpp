@@ -0,0 +1,226 @@
+#pragma once
+
+#include "CoarseClock.hpp"
+#include "FlatMap.hpp"
+#include "Hash.hpp"
+#include "NodePool.hpp"
+#include "TimingWheel.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 节点的附加信息：过期时刻、权重和写后刷新状态
+ *
+ * 只有设置了过期时间、权重不为 1 或记录了写入时刻的节点才有，字段全部回到默认值时即被回收。
+ */
+template <typename NodeType>
+struct NodeMeta
+{
+    NodeType*            node{nullptr};      // 所属节点，也是索引中的键
+    std::int64_t         expireAt{};         // 过期时刻（CoarseClock 毫秒），0 为永不过期
+    std::int64_t         weight{1};          // 写入时计算的权重
+    std::int64_t         writeAt{};          // 最近写入时刻，开启写后刷新时才记录
+    bool                 refreshing{};       // 已提交后台刷新，写入或刷新完成时清除
+    NodeMeta<NodeType>*  timerNext{nullptr}; // 时间轮槽位链表
+    NodeMeta<NodeType>** timerPrev{nullptr}; // 前驱的 timerNext，为空表示不在时间轮中
+};
+
+/**
+ * @brief 按节点地址保存附加信息的旁路表，并用时间轮组织设置了过期时间的记录
+ *
+ * 不使用 ttl、权重和写后刷新时表始终为空，节点只有键、值、哈希和链表指针，查询只多一次判空。
+ * 节点被回收前必须调用 release，否则复用同一地址的新节点会读到旧记录。不加锁，由所属缓存在
+ * 自己的锁内调用。
+ */
+template <typename NodeType>
+class NodeMetaTable
+{
+    using Meta    = NodeMeta<NodeType>;
+    using MetaPtr = Meta*;
+
+    // 索引的取键方式：键为记录所属节点的地址，存放在记录中
+    struct OwnerKey
+    {
+        NodeType* const& operator()(MetaPtr meta) const { return meta->node; }
+    };
+
+    using MetaIndex =
+        FlatMap<NodeType*, MetaPtr, DefaultHash<NodeType*>, std::equal_to<>, OwnerKey>;
+
+    MetaIndex         index_; // 节点地址->附加记录，第一次写入记录时才分配
+    NodePool<Meta>    pool_;  // 记录池，回收的记录循环使用
+    TimingWheel<Meta> wheel_; // 设置了过期时间的记录
+
+  public:
+    NodeMetaTable() = default;
+
+    NodeMetaTable(const NodeMetaTable&)            = delete;
+    NodeMetaTable& operator=(const NodeMetaTable&) = delete;
+
+    bool        empty() const { return index_.empty(); }
+    std::size_t size() const { return index_.size(); }
+
+    // 节点的记录，没有时返回空
+    MetaPtr find(NodeType* node) const
+    {
+        if (index_.empty())
+            return nullptr;
+        const MetaPtr* slot = index_.find(node);
+        return slot ? *slot : nullptr;
+    }
+
+    std::int64_t weightOf(NodeType* node) const
+    {
+        MetaPtr meta = find(node);
+        return meta ? meta->weight : 1;
+    }
+
+    // 只有设置了过期时间的节点才读取时钟
+    bool expired(NodeType* node) const
+    {
+        MetaPtr meta = find(node);
+        return meta && meta->expireAt != 0 && meta->expireAt <= CoarseClock::now();
+    }
+
+    bool refreshing(NodeType* node) const
+    {
+        MetaPtr meta = find(node);
+        return meta && meta->refreshing;
+    }
+
+    // 距上次写入超过 interval 且没有刷新在进行，没有写入时刻的节点视为需要刷新
+    bool refreshDue(NodeType* node, std::int64_t interval) const
+    {
+        MetaPtr meta = find(node);
+        if (meta && meta->refreshing)
+            return false;
+        return (meta ? meta->writeAt : 0) + interval <= CoarseClock::now();
+    }
+
+    /**
+     * @brief 写入后更新节点的附加信息，正在进行的刷新随之作废
+     * @param expireAt 过期时刻，0 为永不过期
+     */
+    void assign(NodeType* node, std::int64_t weight, std::int64_t writeAt, std::int64_t expireAt);
+
+    /**
+     * @brief 后台刷新写入新值后更新权重和写入时刻，清除刷新标记，过期时刻保持不变
+     */
+    void refreshed(NodeType* node, std::int64_t weight, std::int64_t writeAt);
+
+    void setRefreshing(NodeType* node, bool refreshing);
+
+    /**
+     * @brief 节点被回收前丢弃它的记录，返回节点的权重
+     */
+    std::int64_t release(NodeType* node);
+
+    bool timersEmpty() const { return wheel_.empty(); }
+
+    /**
+     * @brief 推进时间轮，对过期的节点调用 onExpire(node)，回调可以 release 该节点
+     * @return 本次处理的过期节点数
+     */
+    template <typename Expire>
+    std::size_t expire(std::int64_t now, std::size_t limit, Expire&& onExpire)
+    {
+        return wheel_.advance(now, limit, [&](MetaPtr meta) { onExpire(meta->node); });
+    }
+
+    // 丢弃所有记录，节点本身由调用方回收
+    void clear();
+
+  private:
+    MetaPtr acquire(NodeType* node);
+    void    drop(MetaPtr meta);
+};
+
+template <typename NodeType>
+void NodeMetaTable<NodeType>::assign(NodeType* node, std::int64_t weight, std::int64_t writeAt,
+                                     std::int64_t expireAt)
+{
+    MetaPtr meta = find(node);
+    if (weight == 1 && writeAt == 0 && expireAt == 0)
+    {
+        if (meta)
+            drop(meta);
+        return;
+    }
+    if (!meta)
+        meta = acquire(node);
+    wheel_.cancel(meta);
+    meta->weight     = weight;
+    meta->writeAt    = writeAt;
+    meta->refreshing = false;
+    meta->expireAt   = expireAt;
+    if (expireAt != 0)
+        wheel_.schedule(meta, CoarseClock::now());
+}
+
+template <typename NodeType>
+void NodeMetaTable<NodeType>::refreshed(NodeType* node, std::int64_t weight, std::int64_t writeAt)
+{
+    MetaPtr meta = find(node);
+    if (!meta)
+    {
+        if (weight == 1 && writeAt == 0)
+            return;
+        meta = acquire(node);
+    }
+    meta->weight     = weight;
+    meta->writeAt    = writeAt;
+    meta->refreshing = false;
+    if (weight == 1 && writeAt == 0 && meta->expireAt == 0)
+        drop(meta);
+}
+
+template <typename NodeType>
+void NodeMetaTable<NodeType>::setRefreshing(NodeType* node, bool refreshing)
+{
+    MetaPtr meta = find(node);
+    if (!meta)
+    {
+        if (!refreshing)
+            return;
+        meta = acquire(node);
+    }
+    meta->refreshing = refreshing;
+    if (!refreshing && meta->weight == 1 && meta->writeAt == 0 && meta->expireAt == 0)
+        drop(meta);
+}
+
+template <typename NodeType>
+std::int64_t NodeMetaTable<NodeType>::release(NodeType* node)
+{
+    MetaPtr meta = find(node);
+    if (!meta)
+        return 1;
+    std::int64_t weight = meta->weight;
+    drop(meta);
+    return weight;
+}
+
+template <typename NodeType>
+void NodeMetaTable<NodeType>::clear()
+{
+    wheel_.clear();
+    index_.clear();
+    pool_.clear();
+}
+
+template <typename NodeType>
+typename NodeMetaTable<NodeType>::MetaPtr NodeMetaTable<NodeType>::acquire(NodeType* node)
+{
+    MetaPtr meta = pool_.acquire();
+    meta->node   = node;
+    index_.insert(index_.hashOf(node), meta);
+    return meta;
+}
+
+template <typename NodeType>
+void NodeMetaTable<NodeType>::drop(MetaPtr meta)
+{
+    wheel_.cancel(meta);
+    index_.erase(meta->node);
+    pool_.release(meta);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 节点池：按块预分配节点，被淘汰的节点回收后循环使用
+ *
+ * 节点块一旦分配就不再移动，因此可以用原始指针链接节点；
+ * 回收的节点会被重置为默认状态（prev/next 为空），不会归还给系统，直到 clear 或析构。
+ */
+template <typename NodeType>
+class NodePool
+{
+    std::size_t                              chunkSize_; // 每块节点数量
+    std::size_t                              used_{};    // 已从块中切分出的节点数量（含空闲节点）
+    std::vector<std::unique_ptr<NodeType[]>> chunks_;    // 节点块
+    std::vector<NodeType*>                   free_;      // 回收的空闲节点
+
+  public:
+    explicit NodePool(std::size_t chunkSize = 64);
+
+    NodePool(const NodePool&)            = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * @brief 取出一个节点，优先复用已回收的节点
+     */
+    NodeType* acquire();
+
+    /**
+     * @brief 回收节点，节点内容被重置
+     */
+    void release(NodeType* node);
+
+    /**
+     * @brief 释放所有节点块
+     */
+    void clear();
+
+    // 已切分出的节点槽位数量，槽位下标在 [0, slotCount()) 内稳定
+    std::size_t slotCount() const { return used_; }
+    // 正在使用中的节点数量
+    std::size_t liveCount() const { return used_ - free_.size(); }
+    // 按下标访问槽位（可能是空闲节点）
+    NodeType* slotAt(std::size_t index) const
+    {
+        return &chunks_[index / chunkSize_][index % chunkSize_];
+    }
+    // 节点块占用的字节数
+    std::size_t bytesReserved() const { return chunks_.size() * chunkSize_ * sizeof(NodeType); }
+};
+
+template <typename NodeType>
+NodePool<NodeType>::NodePool(std::size_t chunkSize) : chunkSize_(chunkSize > 0 ? chunkSize : 1)
+{
+}
+
+template <typename NodeType>
+NodeType* NodePool<NodeType>::acquire()
+{
+    if (!free_.empty())
+    {
+        NodeType* node = free_.back();
+        free_.pop_back();
+        return node;
+    }
+
+    if (used_ == chunks_.size() * chunkSize_)
+        chunks_.emplace_back(std::make_unique<NodeType[]>(chunkSize_));
+
+    NodeType* node = slotAt(used_);
+    used_++;
+    return node;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::release(NodeType* node)
+{
+    *node = NodeType{};
+    free_.push_back(node);
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::clear()
+{
+    free_.clear();
+    chunks_.clear();
+    used_ = 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @brief 提示 CPU 把 address 所在的缓存行载入缓存
+ *
+ * 预取只是提示：不阻塞、不改变程序语义，地址无效也不会出错。
+ * 批量查找时先为一组键发出预取，再回头完成查找，多个键的内存访问延迟得以重叠。
+ */
+inline void prefetchRead(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+/**
+ * @brief 与 prefetchRead 相同，但提示随后会写入该缓存行
+ */
+inline void prefetchWrite(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 1, 3);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
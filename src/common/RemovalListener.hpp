@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 条目被移除的原因
+ */
+enum class RemovalCause
+{
+    Size,     // 容量不足被淘汰，或新值权重超限被拒绝
+    Expired,  // 过期
+    Replaced, // 被新值覆盖，事件中是旧值
+    Explicit, // 调用方主动删除或清空
+};
+
+/**
+ * @brief 移除监听器，在缓存锁外调用，可以安全地访问缓存本身；抛出的异常被忽略
+ */
+template <typename KeyType, typename ValueType>
+using RemovalListener = std::function<void(const KeyType&, const ValueType&, RemovalCause)>;
+
+/**
+ * @brief 移除事件缓冲区，每个缓存（分片缓存的每个分片）一个
+ *
+ * 持有缓存锁时只把事件追加到缓冲区，释放锁之后再整批交给监听器，淘汰本身不会因为监听器
+ * 变慢，监听器里也可以再访问缓存。未设置监听器时 record 只是一次判空。
+ * 除 Batch::deliver 外都要求调用方持有所属缓存的锁。
+ */
+template <typename KeyType, typename ValueType>
+class RemovalNotifier
+{
+    using Listener = RemovalListener<KeyType, ValueType>;
+
+    struct Event
+    {
+        KeyType      key;
+        ValueType    value;
+        RemovalCause cause;
+    };
+
+    std::shared_ptr<const Listener> listener_;   // 取出的批次持有副本，投递期间替换监听器是安全的
+    ThreadPool*                     executor_{}; // 投递事件的线程池，为空时在锁外同步投递
+    std::vector<Event>              pending_;    // 尚未投递的事件
+
+  public:
+    /**
+     * @brief 一次临界区内积攒的事件，连同当时的监听器一起取出，在锁外投递
+     */
+    class Batch
+    {
+        std::shared_ptr<const Listener> listener_;
+        ThreadPool*                     executor_{};
+        std::vector<Event>              events_;
+
+        friend class RemovalNotifier;
+
+      public:
+        // 有执行器时提交给它，队列已满则在当前线程投递，事件不会丢失
+        void deliver()
+        {
+            if (events_.empty() || !listener_)
+                return;
+            if (executor_)
+            {
+                // 提交失败时还要在当前线程投递，事件放在共享的批次里，不随任务一起销毁
+                auto batch = std::make_shared<Batch>(std::move(*this));
+                if (executor_->trySubmit([batch] { dispatch(*batch->listener_, batch->events_); }))
+                    return;
+                dispatch(*batch->listener_, batch->events_);
+                return;
+            }
+            dispatch(*listener_, events_);
+        }
+
+      private:
+        static void dispatch(const Listener& listener, const std::vector<Event>& events)
+        {
+            for (const Event& event : events)
+            {
+                try
+                {
+                    listener(event.key, event.value, event.cause);
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+    };
+
+    RemovalNotifier() = default;
+
+    RemovalNotifier(const RemovalNotifier&)            = delete;
+    RemovalNotifier& operator=(const RemovalNotifier&) = delete;
+
+    /**
+     * @brief 设置监听器，listener 为空时关闭通知
+     * @param executor 投递事件的线程池，为空时由触发移除的线程在释放锁后投递
+     */
+    void setListener(Listener listener, ThreadPool* executor)
+    {
+        listener_ = listener ? std::make_shared<const Listener>(std::move(listener)) : nullptr;
+        executor_ = executor;
+    }
+
+    bool enabled() const { return listener_ != nullptr; }
+    bool hasPending() const { return !pending_.empty(); }
+
+    template <typename K, typename V>
+    void record(K&& key, V&& value, RemovalCause cause)
+    {
+        if (listener_)
+            pending_.push_back(Event{std::forward<K>(key), std::forward<V>(value), cause});
+    }
+
+    Batch take()
+    {
+        Batch batch;
+        batch.listener_ = listener_;
+        batch.executor_ = executor_;
+        batch.events_.swap(pending_);
+        return batch;
+    }
+};
+
+/**
+ * @brief 带移除通知的独占锁：析构时取出本次积攒的事件，释放锁之后再投递
+ *
+ * 持锁的子类接口（如 putLocked）产生的事件留在缓冲区，由下一次经过本锁的操作一并投递。
+ */
+template <typename Notifier, typename Mutex>
+class RemovalGuard
+{
+    std::unique_lock<Mutex> lock_;
+    Notifier&               notifier_;
+
+  public:
+    RemovalGuard(Mutex& mutex, Notifier& notifier) : lock_(mutex), notifier_(notifier) {}
+
+    ~RemovalGuard()
+    {
+        if (!notifier_.hasPending())
+            return;
+        typename Notifier::Batch batch = notifier_.take();
+        lock_.unlock();
+        batch.deliver();
+    }
+
+    RemovalGuard(const RemovalGuard&)            = delete;
+    RemovalGuard& operator=(const RemovalGuard&) = delete;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "FlatMap.hpp"
+#include "Hash.hpp"
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief 合并同一个键的并发加载
+ *
+ * 第一个调用者执行加载，其余同时到达的调用者等待同一个 future 并共享结果，
+ * 加载抛出的异常同样传给所有等待者。加载结束后记录即被删除，之后的调用会重新加载，
+ * 因此调用方应在加载成功后把结果写入缓存。
+ */
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>>
+class SingleFlight
+{
+    std::mutex                                              mutex_; // 保护 calls_
+    FlatMap<KeyType, std::shared_future<ValueType>, Hasher> calls_; // 正在进行的加载
+
+  public:
+    SingleFlight() = default;
+
+    SingleFlight(const SingleFlight&)            = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    /**
+     * @brief 执行或等待 key 的加载
+     * @param load 无参可调用对象，返回加载到的值
+     */
+    template <typename Load>
+    ValueType run(const KeyType& key, Load&& load)
+    {
+        return run(key, calls_.hashOf(key), std::forward<Load>(load));
+    }
+
+    // hash 为调用方已经算好的 Hasher{}(key)，与缓存索引共用，不再重新计算
+    template <typename Load>
+    ValueType run(const KeyType& key, std::size_t hash, Load&& load);
+};
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Load>
+ValueType SingleFlight<KeyType, ValueType, Hasher>::run(const KeyType& key, std::size_t hash,
+                                                        Load&& load)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (const auto* call = calls_.find(key, hash))
+    {
+        // 已有加载在进行，释放锁后等待它的结果
+        std::shared_future<ValueType> pending = *call;
+        lock.unlock();
+        return pending.get();
+    }
+
+    std::promise<ValueType> promise;
+    calls_.insert(hash, key, promise.get_future().share());
+    lock.unlock();
+
+    // 先交付结果再删除记录：删除前到达的调用者仍能拿到这次的结果
+    try
+    {
+        ValueType value = std::forward<Load>(load)();
+        promise.set_value(value);
+        lock.lock();
+        calls_.erase(key, hash);
+        return value;
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+        lock.lock();
+        calls_.erase(key, hash);
+        throw;
+    }
+}
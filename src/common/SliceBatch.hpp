@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Hash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 分片缓存批量操作的分组结果
+ *
+ * 每个键只计算一次哈希，再按所在分片做计数排序，得到每个分片要处理的键下标。
+ * 分片内部用同样的哈希查找，不必重新计算。
+ */
+class SliceBatch
+{
+    std::vector<std::size_t>   hashes_;    // hashes_[i] 为 keys[i] 的哈希
+    std::vector<std::uint32_t> positions_; // 按分片排列的键下标
+    std::vector<std::size_t>   offsets_;   // 分片 s 的下标范围 [offsets_[s], offsets_[s + 1])
+
+  public:
+    template <typename KeyType, typename Hasher>
+    SliceBatch(const KeyType* keys, std::size_t count, std::size_t sliceCount,
+               const Hasher& hasher);
+
+    const std::size_t* hashes() const { return hashes_.data(); }
+
+    // 分片 slice 要处理的键下标及数量
+    const std::uint32_t* positions(std::size_t slice) const
+    {
+        return positions_.data() + offsets_[slice];
+    }
+    std::size_t size(std::size_t slice) const { return offsets_[slice + 1] - offsets_[slice]; }
+};
+
+template <typename KeyType, typename Hasher>
+SliceBatch::SliceBatch(const KeyType* keys, std::size_t count, std::size_t sliceCount,
+                       const Hasher& hasher)
+    : hashes_(count), positions_(count), offsets_(sliceCount + 1)
+{
+    for (std::size_t i = 0; i < count; i++)
+    {
+        hashes_[i] = hasher(keys[i]);
+        offsets_[sliceOf(hashes_[i], sliceCount) + 1]++;
+    }
+    for (std::size_t s = 0; s < sliceCount; s++) offsets_[s + 1] += offsets_[s];
+
+    // 借用 offsets_ 作为各分片的写入位置，写完后整体右移了一个分片，再恢复
+    for (std::size_t i = 0; i < count; i++)
+        positions_[offsets_[sliceOf(hashes_[i], sliceCount)]++] = static_cast<std::uint32_t>(i);
+    for (std::size_t s = sliceCount; s > 0; s--) offsets_[s] = offsets_[s - 1];
+    offsets_[0] = 0;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 固定线程数、有界队列的线程池
+ *
+ * 队列满时 trySubmit 直接返回 false，由调用方决定放弃还是自己执行，提交方永远不会被阻塞。
+ * 析构时丢弃尚未开始的任务，等待正在执行的任务结束；任务抛出的异常被吞掉，不影响工作线程。
+ */
+class ThreadPool
+{
+    std::mutex                        mutex_;     // 保护 tasks_ 与 stop_
+    std::condition_variable           ready_;     // 有新任务或需要退出
+    std::deque<std::function<void()>> tasks_;     // 等待执行的任务
+    std::size_t                       maxQueued_; // 队列长度上限
+    bool                              stop_{};    // 通知工作线程退出
+    std::vector<std::thread>          workers_;   // 工作线程，最后构造
+
+  public:
+    ThreadPool(std::size_t threads, std::size_t maxQueued)
+        : maxQueued_(std::max<std::size_t>(maxQueued, 1))
+    {
+        threads = std::max<std::size_t>(threads, 1);
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; i++) workers_.emplace_back([this] { run(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            tasks_.clear();
+        }
+        ready_.notify_all();
+        for (std::thread& worker : workers_) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 提交任务，队列已满或线程池正在析构时返回 false
+     */
+    bool trySubmit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_ || tasks_.size() >= maxQueued_)
+                return false;
+            tasks_.push_back(std::move(task));
+        }
+        ready_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 缓存后台任务共用的线程池：最多 4 个线程，队列最多 4096 个任务，第一次使用时创建
+     */
+    static ThreadPool& shared()
+    {
+        static ThreadPool pool(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u), 4096);
+        return pool;
+    }
+
+  private:
+    void run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (stop_)
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+};
+
+/**
+ * @brief 某个缓存提交到线程池的任务集合
+ *
+ * 线程池比缓存活得久，排队中的任务可能在缓存析构之后才轮到执行。close 之后尚未开始的任务
+ * 直接跳过，并等待已经开始的任务结束，缓存在析构时调用 close 即可安全地释放自身。
+ */
+class TaskGroup
+{
+    struct State
+    {
+        std::mutex              mutex;
+        std::condition_variable idle;      // running 归零
+        int                     running{}; // 正在执行的任务数
+        bool                    closed{};  // 之后轮到的任务不再执行
+    };
+
+    ThreadPool*            pool_; // 为空时使用共享线程池，第一次提交时才创建
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+
+  public:
+    explicit TaskGroup(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~TaskGroup() { close(); }
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * @brief 提交任务，线程池队列已满或已 close 时返回 false，任务不会执行
+     */
+    template <typename Task>
+    bool submit(Task&& task)
+    {
+        std::shared_ptr<State> state = state_;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->closed)
+                return false;
+        }
+        ThreadPool& pool = pool_ ? *pool_ : ThreadPool::shared();
+        return pool.trySubmit(
+            [state, task = std::forward<Task>(task)]() mutable
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (state->closed)
+                        return;
+                    state->running++;
+                }
+                // 任务异常由任务自己处理，这里只保证计数正确
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (--state->running == 0)
+                    state->idle.notify_all();
+            });
+    }
+
+    /**
+     * @brief 不再执行尚未开始的任务，并等待正在执行的任务结束；不能在本组的任务中调用
+     */
+    void close()
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->closed = true;
+        state_->idle.wait(lock, [this] { return state_->running == 0; });
+    }
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief 当前线程的条带编号，调用方按 & (条带数 - 1) 取用
+ *
+ * 线程第一次调用时按轮转分配，之后不变；线程数不超过条带数时各线程独占一个条带。
+ */
+inline std::size_t threadStripe()
+{
+    static std::atomic<std::size_t> nextStripe{0};
+    thread_local std::size_t        stripe = nextStripe.fetch_add(1, std::memory_order_relaxed);
+    return stripe;
+}
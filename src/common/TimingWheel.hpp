@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 分层时间轮，按过期时刻（毫秒）组织节点
+ *
+ * 共 4 层，每层 64 个槽位：第 0 层每个槽位 1ms，第 1 层 64ms，第 2 层约 4s，第 3 层约 4min，
+ * 合计覆盖约 4.6 小时，更远的节点暂放在最高层、到期前再按实际时刻重新放置。
+ * 插入、取消都是 O(1)；推进时逐个处理第 0 层到期的槽位，每进入上一层的新槽位就把它的节点
+ * 级联下放到更低层，每个节点最多被级联 3 次。第 0 层用位图跳过空槽位。
+ *
+ * 侵入式实现：节点类型需要有 expireAt、timerNext、timerPrev 字段（timerPrev 指向前驱的 timerNext
+ * 或槽位头指针，为空表示不在时间轮中）。时间轮不拥有节点，也不加锁，由所属缓存在自己的锁内调用。
+ */
+template <typename NodeType>
+class TimingWheel
+{
+    // 层数、每层槽位数，以及整个时间轮覆盖的时间范围（毫秒）
+    static constexpr int          kLevels   = 4;
+    static constexpr int          kSlotBits = 6;
+    static constexpr std::int64_t kSlots    = std::int64_t{1} << kSlotBits;
+    static constexpr std::int64_t kSlotMask = kSlots - 1;
+    static constexpr std::int64_t kSpan     = std::int64_t{1} << (kSlotBits * kLevels);
+
+    NodeType*     slots_[kLevels][kSlots]{}; // 槽位链表头
+    std::uint64_t occupied_{};               // 第 0 层可能非空的槽位，被取消清空的槽位不会清零
+    std::int64_t  currentTick_{};            // 已推进到的时刻，它的第 0 层槽位可能尚未处理完
+    std::size_t   size_{};                   // 节点数量
+
+  public:
+    TimingWheel() = default;
+
+    TimingWheel(const TimingWheel&)            = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    bool        empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief 按 node->expireAt 放入时间轮，节点不能已在时间轮中
+     * @param now 当前时刻，时间轮为空时直接跳到该时刻
+     */
+    void schedule(NodeType* node, std::int64_t now);
+
+    /**
+     * @brief 从时间轮中取出节点，不在时间轮中时什么也不做
+     */
+    void cancel(NodeType* node);
+
+    /**
+     * @brief 推进到 now，对过期的节点调用 expire(node)，节点在回调前已从时间轮取出
+     * @param limit 本次最多处理的过期节点数，剩余的留到下次推进，单次耗时有上界
+     * @return 本次处理的过期节点数
+     */
+    template <typename Expire>
+    std::size_t advance(std::int64_t now, std::size_t limit, Expire&& expire);
+
+    /**
+     * @brief 丢弃所有节点，节点本身由调用方回收
+     */
+    void clear();
+
+  private:
+    // 按过期时刻与 currentTick_ 的距离选择层和槽位
+    void link(NodeType* node);
+    void pushFront(NodeType*& head, NodeType* node);
+    void unlink(NodeType* node);
+
+    // 进入时刻 tick 时，把上层对应槽位的节点下放
+    void cascade(std::int64_t tick);
+
+    static int lowestBit(std::uint64_t bits);
+};
+
+template <typename NodeType>
+void TimingWheel<NodeType>::schedule(NodeType* node, std::int64_t now)
+{
+    // 空时间轮可能已很久没有推进，直接跳到当前时刻，避免下次推进时逐个走过空槽位
+    if (size_ == 0 && currentTick_ < now)
+    {
+        currentTick_ = now;
+        occupied_    = 0;
+    }
+    link(node);
+    size_++;
+}
+
+template <typename NodeType>
+void TimingWheel<NodeType>::cancel(NodeType* node)
+{
+    if (!node->timerPrev)
+        return;
+    unlink(node);
+    size_--;
+}
+
+template <typename NodeType>
+template <typename Expire>
+std::size_t TimingWheel<NodeType>::advance(std::int64_t now, std::size_t limit, Expire&& expire)
+{
+    std::size_t expired = 0;
+    while (true)
+    {
+        // 先处理当前时刻的槽位，上次可能因数量上限没有处理完
+        NodeType*& head = slots_[0][currentTick_ & kSlotMask];
+        while (head && expired < limit)
+        {
+            NodeType* node = head;
+            unlink(node);
+            size_--;
+            expire(node);
+            expired++;
+        }
+        if (head)
+            return expired;
+        occupied_ &= ~(std::uint64_t{1} << (currentTick_ & kSlotMask));
+
+        if (currentTick_ >= now)
+            return expired;
+        if (size_ == 0)
+        {
+            currentTick_ = now;
+            return expired;
+        }
+
+        // 下一个要处理的时刻：本轮第 0 层下一个非空槽位，没有则是下一轮的起点（需要级联）
+        std::int64_t next   = currentTick_ + 1;
+        std::int64_t target = next;
+        if ((next & kSlotMask) != 0)
+        {
+            std::uint64_t ahead = occupied_ >> (next & kSlotMask);
+            target              = ahead ? next + lowestBit(ahead) : (next | kSlotMask) + 1;
+        }
+        if (target > now)
+        {
+            currentTick_ = now;
+            return expired;
+        }
+        currentTick_ = target;
+        if ((target & kSlotMask) == 0)
+            cascade(target);
+    }
+}
+
+template <typename NodeType>
+void TimingWheel<NodeType>::clear()
+{
+    for (auto& level : slots_)
+        for (NodeType*& head : level) head = nullptr;
+    occupied_ = 0;
+    size_     = 0;
+}
+
+template <typename NodeType>
+void TimingWheel<NodeType>::link(NodeType* node)
+{
+    std::int64_t expireAt = node->expireAt;
+    std::int64_t delta    = expireAt - currentTick_;
+    if (delta <= 0)
+    {
+        // 已经过期：放入当前槽位，下次推进时立即处理
+        pushFront(slots_[0][currentTick_ & kSlotMask], node);
+        occupied_ |= std::uint64_t{1} << (currentTick_ & kSlotMask);
+        return;
+    }
+    if (delta >= kSpan)
+    {
+        // 超出覆盖范围：先放在最高层最远的槽位，级联时按实际过期时刻重新放置
+        expireAt = currentTick_ + kSpan - 1;
+    }
+
+    int level = 0;
+    while ((expireAt - currentTick_) >> (kSlotBits * (level + 1)) != 0) level++;
+    std::int64_t slot = (expireAt >> (kSlotBits * level)) & kSlotMask;
+    pushFront(slots_[level][slot], node);
+    if (level == 0)
+        occupied_ |= std::uint64_t{1} << slot;
+}
+
+template <typename NodeType>
+void TimingWheel<NodeType>::pushFront(NodeType*& head, NodeType* node)
+{
+    node->timerNext = head;
+    node->timerPrev = &head;
+    if (head)
+        head->timerPrev = &node->timerNext;
+    head = node;
+}
+
+template <typename NodeType>
+void TimingWheel<NodeType>::unlink(NodeType* node)
+{
+    *node->timerPrev = node->timerNext;
+    if (node->timerNext)
+        node->timerNext->timerPrev = node->timerPrev;
+    node->timerPrev = nullptr;
+    node->timerNext = nullptr;
+}
+
+template <typename NodeType>
+void TimingWheel<NodeType>::cascade(std::int64_t tick)
+{
+    for (int level = 1; level < kLevels; level++)
+    {
+        std::int64_t slot   = (tick >> (kSlotBits * level)) & kSlotMask;
+        NodeType*    node   = slots_[level][slot];
+        slots_[level][slot] = nullptr;
+        while (node)
+        {
+            NodeType* next = node->timerNext;
+            link(node);
+            node = next;
+        }
+        // 本层没有进入新一轮，更高层不需要级联
+        if (slot != 0)
+            break;
+    }
+}
+
+template <typename NodeType>
+int TimingWheel<NodeType>::lowestBit(std::uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while ((bits & 1) == 0)
+    {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+/**
+ * @brief 条目权重函数，返回条目占用的权重（如字节数）
+ *
+ * 权重在写入时计算一次并记录在节点中，淘汰时按记录的值归还，不会重新计算。
+ */
+template <typename KeyType, typename ValueType>
+using Weigher = std::function<std::size_t(const KeyType&, const ValueType&)>;
+
+/**
+ * @brief 缓存的权重预算
+ *
+ * 未设置权重函数时每个条目权重为 1，容量即条目数量，与按条目计数完全一致。
+ * 设置后容量按权重计，写入时淘汰到总权重能容纳新条目为止；
+ * 权重超过 容量 * admissionFraction 的条目直接拒绝写入，避免一个大条目冲掉整个缓存。
+ * 不加锁，由所属缓存在自己的锁内调用。
+ */
+template <typename KeyType, typename ValueType>
+class WeightBudget
+{
+    std::int64_t                capacity_;          // 权重上限
+    std::int64_t                used_{};            // 当前总权重
+    double                      admissionFraction_; // 单个条目权重上限占容量的比例
+    Weigher<KeyType, ValueType> weigher_;           // 为空时每个条目权重为 1
+
+  public:
+    WeightBudget(std::int64_t capacity, Weigher<KeyType, ValueType> weigher,
+                 double admissionFraction)
+        : capacity_(capacity)
+        , admissionFraction_(admissionFraction)
+        , weigher_(std::move(weigher))
+    {
+    }
+
+    std::int64_t capacity() const { return capacity_; }
+    std::int64_t used() const { return used_; }
+    bool         weighted() const { return static_cast<bool>(weigher_); }
+
+    std::int64_t weigh(const KeyType& key, const ValueType& value) const
+    {
+        return weigher_ ? static_cast<std::int64_t>(weigher_(key, value)) : 1;
+    }
+
+    // 按当前容量判断，容量被再平衡调整后上限随之变化
+    bool admits(std::int64_t weight) const
+    {
+        return !weigher_ || weight <= static_cast<double>(capacity_) * admissionFraction_;
+    }
+
+    // 再加入 incoming 的权重后是否超出容量
+    bool overflows(std::int64_t incoming) const { return used_ + incoming > capacity_; }
+
+    void charge(std::int64_t weight) { used_ += weight; }
+    void discharge(std::int64_t weight) { used_ -= weight; }
+    void clear() { used_ = 0; }
+
+    // 调整容量，结果至少为 1
+    void resize(std::int64_t delta) { capacity_ = std::max<std::int64_t>(capacity_ + delta, 1); }
+};
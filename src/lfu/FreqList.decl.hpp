@@ -1,23 +1,54 @@
 #pragma once
 
-#include "../common/Node.hpp"
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType, typename Hasher>
 class LFUCache;
 
+template <typename KeyType, typename ValueType>
+class FreqList;
+
+/**
+ * @brief LFU 的节点：在链表节点的字段之外记录频次、老化纪元和所在的频次桶
+ */
+template <typename KeyType, typename ValueType>
+struct FreqNode
+{
+    KeyType                       key;
+    ValueType                     value;
+    std::size_t                   hash{};          // 索引中缓存的哈希值
+    FreqNode<KeyType, ValueType>* prev{nullptr};   // 所在频次桶中的相邻节点
+    FreqNode<KeyType, ValueType>* next{nullptr};
+    int                           freq{1};         // 访问频次
+    std::uint32_t                 epoch{};         // 频次最后一次老化时的纪元
+    FreqList<KeyType, ValueType>* bucket{nullptr}; // 所在的频次桶
+};
+
+/**
+ * @brief 频次桶：同一频次的节点组成的链表
+ *
+ * 桶之间按频次升序组成双向链表，节点通过 bucket 字段指向所在的桶，
+ * 访问时只需移动到相邻的桶，不必按频次查找。
+ */
 template <typename KeyType, typename ValueType>
 class FreqList
 {
-    using NodeType = Node<KeyType, ValueType>;
-    using NodePtr  = std::shared_ptr<NodeType>;
+    using NodeType = FreqNode<KeyType, ValueType>;
+    using NodePtr  = NodeType*;
 
-    int     freq_;
-    NodePtr head_;
-    NodePtr tail_;
+    int           freq_;
+    std::uint32_t epoch_{};       // 频次最后一次老化时的纪元
+    NodeType      head_;          // 虚拟头节点
+    NodeType      tail_;          // 虚拟尾节点
+    FreqList*     prev_{nullptr}; // 频次更低的相邻桶
+    FreqList*     next_{nullptr}; // 频次更高的相邻桶
 
   public:
-    FreqList(int freq);
+    FreqList(int freq = 1);
+
+    FreqList(const FreqList&)            = delete;
+    FreqList& operator=(const FreqList&) = delete;
 
     bool empty() const;
 
@@ -27,5 +58,6 @@ class FreqList
 
     NodePtr getEarliestNode() const;
 
-    friend class LFUCache<KeyType, ValueType>;
+    template <typename K, typename V, typename Hasher>
+    friend class LFUCache;
 };
@@ -1,44 +1,44 @@
+#pragma once
+
 #include "FreqList.decl.hpp"
-#include <string>
 
 template <typename KeyType, typename ValueType>
 FreqList<KeyType, ValueType>::FreqList(int freq)
-    : freq_(freq), head_(std::make_shared<NodeType>()), tail_(std::make_shared<NodeType>())
+    : freq_(freq)
 {
-    head_->next = tail_;
-    tail_->prev = head_;
+    head_.next = &tail_;
+    tail_.prev = &head_;
 }
 
 template <typename KeyType, typename ValueType>
 bool FreqList<KeyType, ValueType>::empty() const
 {
-    return head_->next == tail_;
+    return head_.next == &tail_;
 }
 
 template <typename KeyType, typename ValueType>
 void FreqList<KeyType, ValueType>::addNode(typename FreqList<KeyType, ValueType>::NodePtr node)
 {
-    node->next        = head_->next;
-    node->prev        = head_;
-    head_->next->prev = node;
-    head_->next       = node;
+    node->next       = head_.next;
+    node->prev       = &head_;
+    node->bucket     = this;
+    head_.next->prev = node;
+    head_.next       = node;
 }
 
 template <typename KeyType, typename ValueType>
 void FreqList<KeyType, ValueType>::removeNode(typename FreqList<KeyType, ValueType>::NodePtr node)
 {
-    node->prev.lock()->next = node->next;
-    node->next->prev        = node->prev;
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
 
-    node->next.reset();
-    node->prev.reset();
+    node->next   = nullptr;
+    node->prev   = nullptr;
+    node->bucket = nullptr;
 }
 
 template <typename KeyType, typename ValueType>
 typename FreqList<KeyType, ValueType>::NodePtr FreqList<KeyType, ValueType>::getEarliestNode() const
 {
-    return tail_->prev.lock();
+    return empty() ? nullptr : tail_.prev;
 }
-
-// 显式模板实例化
-template class FreqList<std::string, int>;
\ No newline at end of file
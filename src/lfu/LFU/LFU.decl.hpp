@@ -1,37 +1,140 @@
 #pragma once
 
 #include "../../common/BaseCache.hpp"
-#include "../../common/Node.hpp"
+#include "../../common/CoarseClock.hpp"
+#include "../../common/FlatMap.hpp"
+#include "../../common/Hash.hpp"
+#include "../../common/NodeMeta.hpp"
+#include "../../common/NodePool.hpp"
+#include "../../common/RemovalListener.hpp"
+#include "../../common/SingleFlight.hpp"
+#include "../../common/ThreadPool.hpp"
+#include "../../common/Weigher.hpp"
 #include "../FreqList.decl.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <shared_mutex>
-#include <unordered_map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>>
 class LFUCache : public BaseCache<KeyType, ValueType>
 {
-    using NodeType = Node<KeyType, ValueType>;
-    using NodePtr  = std::shared_ptr<NodeType>;
-    using NodeMap  = std::unordered_map<KeyType, NodePtr>;
-    using FreqMap  = std::unordered_map<int, std::unique_ptr<FreqList<KeyType, ValueType>>>;
+    using NodeType     = FreqNode<KeyType, ValueType>;
+    using NodePtr      = NodeType*;
+    using NodeMap      = FlatMap<KeyType, NodePtr, Hasher, std::equal_to<>, NodeKey>;
+    using FreqListType = FreqList<KeyType, ValueType>;
+    using FreqListPtr  = FreqListType*;
+    // 会移除条目的操作都用它加锁，释放锁之后投递本次的移除事件
+    using WriteLock = RemovalGuard<RemovalNotifier<KeyType, ValueType>, std::mutex>;
 
-    int capacity_;       // 缓存容量
-    int minFreq_;        // 最小频次（用于找到最小访问频次节点）
-    int maxAverageFreq_; // 最大平均频次
-    int curAverageFreq_; // 当前平均频次
-    int curTotalFreq_;   // 总频次
+    static constexpr int         kMergeSlice  = 16; // 每次操作最多合并的被截断节点数
+    static constexpr std::size_t kExpireBatch = 64; // 每次推进时间轮最多清理的过期节点数
 
-    NodeMap node_map_; // key->node
-    FreqMap freq_map_; // freq->freq_list
+    WeightBudget<KeyType, ValueType> weights_;        // 缓存容量与当前总权重，默认每个条目权重为 1
+    int                              maxAverageFreq_; // 最大平均频次
+    int                              curAverageFreq_; // 当前平均频次
+    int                              curTotalFreq_;   // 总频次（老化后未结算的节点按完整衰减估计）
+    std::uint32_t                    agingEpoch_{};   // 老化纪元，平均频次每超限一次加一
 
-    mutable std::mutex mutex_; // 互斥锁，保护node_map_和freq_map_
+    NodeMap                                    node_map_;          // key->node
+    FreqListPtr                                freqHead_{nullptr}; // 频次最低的桶，即淘汰位置
+    std::vector<std::unique_ptr<FreqListType>> buckets_;           // 所有频次桶的存储
+    std::vector<FreqListPtr>                   freeBuckets_;       // 回收的空桶
+    NodePool<NodeType>                         pool_;              // 节点池，淘汰的节点回收复用
+    NodeMetaTable<NodeType>                    meta_;              // 过期时间、权重和刷新状态
+    std::int64_t                               defaultTtl_{};      // 未指定 ttl 时的过期毫秒数
+
+    SingleFlight<KeyType, ValueType, Hasher> loads_;          // 合并同一个键的并发加载
+    std::int64_t                             refreshAfter_{}; // 写后刷新间隔（毫秒），0 为不刷新
+    TaskGroup                                refreshes_;      // 提交到共享线程池的后台刷新
+
+    mutable std::mutex                  mutex_;    // 互斥锁，保护索引和频次桶
+    RemovalNotifier<KeyType, ValueType> removals_; // 移除事件，由 mutex_ 保护，释放锁后投递
 
   public:
     LFUCache(int capacity, int maxAverageFreq);
 
-    bool      get(KeyType key, ValueType& result) override;
-    ValueType get(KeyType key) override;
-    void      put(KeyType key, ValueType value) override;
+    /**
+     * @brief 按权重计容量的 LFU 缓存
+     * @param capacity 总权重上限（如字节数）
+     * @param maxAverageFreq 最大平均频次
+     * @param weigher 条目权重函数
+     * @param admissionFraction 权重超过 capacity * admissionFraction 的条目拒绝写入
+     */
+    LFUCache(std::int64_t capacity, int maxAverageFreq, Weigher<KeyType, ValueType> weigher,
+             double admissionFraction = 1.0);
+
+    /**
+     * @brief 等待正在执行的后台刷新结束，尚未开始的刷新直接放弃
+     */
+    ~LFUCache() override;
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    /**
+     * @brief 带过期时间的写入，ttl <= 0 表示永不过期
+     *
+     * 过期的条目对 get/peek/contains 立即不可见，占用的位置由时间轮随后续访问分批回收。
+     */
+    void put(const KeyType& key, const ValueType& value, std::chrono::milliseconds ttl);
+    void put(KeyType&& key, ValueType&& value, std::chrono::milliseconds ttl);
+
+    // 设置不指定 ttl 写入时使用的过期时间，只影响之后写入的条目，默认 0 即永不过期
+    void setDefaultTtl(std::chrono::milliseconds ttl);
+
+    /**
+     * @brief 设置写后刷新间隔，interval <= 0 关闭刷新
+     *
+     * 通过 getOrLoad 命中的条目距上次写入超过 interval 时，先返回当前值，再把重新加载提交到
+     * 共享线程池；同一条目同时只有一个刷新，刷新完成前条目被重新写入或淘汰时丢弃刷新结果。
+     * 刷新只替换值，条目的过期时刻和访问频次不变，不计入写入，也不产生覆盖事件。
+     */
+    void setRefreshAfterWrite(std::chrono::milliseconds interval);
+
+    /**
+     * @brief 设置移除监听器，listener 为空时关闭
+     *
+     * 淘汰、过期、覆盖和 purge 都会产生事件。事件在持锁时写入缓冲区，释放锁后由触发移除的
+     * 线程整批投递，或提交给 executor（队列满时退回当前线程投递）；executor 必须比缓存活得久。
+     */
+    void setRemovalListener(RemovalListener<KeyType, ValueType> listener,
+                            ThreadPool*                         executor = nullptr);
+
+    /**
+     * @brief 统计快照，条目数和总权重在持锁时读取
+     */
+    CacheStats stats() const override;
+
+    /**
+     * @brief 查询，未命中时调用 loader(key) 加载并写入缓存
+     *
+     * 同一个键的并发未命中只有一个线程执行 loader，其余线程等待并共享它的结果，值只写入一次；
+     * loader 抛出的异常会传给所有等待的线程，缓存不变。开启写后刷新时 loader 的副本在后台线程
+     * 执行，必须可复制，且在缓存析构前保持可用。
+     */
+    template <typename Loader>
+    ValueType getOrLoad(const KeyType& key, Loader&& loader);
+
+    // 异构查找：如 std::string 键可直接用 std::string_view 查询，不构造临时键
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool get(const K& key, ValueType& result);
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool peek(const K& key, ValueType& result) const;
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool contains(const K& key) const;
+
+    // 批量接口：整批只加一次锁
+    std::size_t getMany(const KeyType* keys, std::size_t count, ValueType* results,
+                        std::uint64_t* hitBits) override;
+    void        putMany(const KeyType* keys, const ValueType* values, std::size_t count) override;
 
     /**
      * @brief 清空数据
@@ -42,9 +145,59 @@ class LFUCache : public BaseCache<KeyType, ValueType>
      * @brief 改变缓存容量
      * @param num 改变的容量
      */
-    void changeCapacity(int num);
+    void changeCapacity(std::int64_t num);
 
   protected:
+    // 以下单键接口的 hash 由调用方算好（须为 Hasher{}(key)），分片缓存选分片时算的哈希直接传入
+
+    /**
+     * @brief getOrLoad 未命中后的加载部分，分片缓存自己完成查询后调用
+     */
+    template <typename Loader>
+    ValueType load(const KeyType& key, std::size_t hash, Loader&& loader);
+
+    /**
+     * @brief getOrLoad 命中过旧条目后的刷新部分，把 loader 的副本提交到线程池
+     */
+    template <typename Loader>
+    void refresh(const KeyType& key, std::size_t hash, Loader&& loader);
+
+    /**
+     * @brief 放弃尚未开始的刷新并等待正在执行的刷新结束，重写了虚函数的子类应在析构时先调用
+     */
+    void stopRefresh();
+
+    /**
+     * @brief 查询的实现
+     * @param stale 不为空时检查写后刷新：条目需要刷新且没有刷新在进行时置为 true，
+     *              并把条目标记为刷新中，调用方必须随后调用 refresh
+     */
+    template <typename K>
+    bool getImpl(const K& key, std::size_t hash, ValueType& result, bool* stale = nullptr);
+
+    /**
+     * @brief peek、contains 和写入的实现，写入按 put 的规则处理过期时间
+     */
+    template <typename K>
+    bool peekImpl(const K& key, std::size_t hash, ValueType& result) const;
+    template <typename K>
+    bool containsImpl(const K& key, std::size_t hash) const;
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value, std::size_t hash);
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value, std::size_t hash, std::chrono::milliseconds ttl);
+
+    /**
+     * @brief 批量接口的实现，只处理 positions 指定下标的键，供分片缓存按分片分组后调用
+     * @param hashes keys[i] 的哈希，为空时现场计算
+     * @param positions 要处理的键下标，为空时处理 [0, count)
+     */
+    std::size_t getManyAt(const KeyType* keys, const std::size_t* hashes,
+                          const std::uint32_t* positions, std::size_t count, ValueType* results,
+                          std::uint64_t* hitBits);
+    void        putManyAt(const KeyType* keys, const ValueType* values, const std::size_t* hashes,
+                          const std::uint32_t* positions, std::size_t count);
+
     /**
      * @brief 移除缓存中最不常访问的数据
      */
@@ -59,7 +212,7 @@ class LFUCache : public BaseCache<KeyType, ValueType>
      * @brief 从频率列表中移除节点
      * @param node 节点
      */
-    void remove(NodePtr& node, bool removeMap = false);
+    void remove(NodePtr node, bool removeMap = false);
 
     /**
      * @brief 减少平均访问等频率
@@ -68,12 +221,33 @@ class LFUCache : public BaseCache<KeyType, ValueType>
     void decreaseTotalFreq(int num);
 
   private:
+    // 要求调用方已持有 mutex_，expireAt 为过期时刻，0 表示永不过期
+    template <typename K, typename V>
+    void putLocked(K&& key, V&& value, std::size_t hash, std::int64_t expireAt);
+
     /**
      * @brief 添加缓存
      * @param key 键
      * @param value 值
+     * @param hash 键的哈希值
+     * @param weight 条目权重
+     * @param expireAt 过期时刻
+     */
+    void putInternal(KeyType key, ValueType value, std::size_t hash, std::int64_t weight,
+                     std::int64_t expireAt);
+
+    /**
+     * @brief 移除任意节点：结算衰减后从频次桶和索引中删除，并扣除它的频次
+     * @param node 节点
+     */
+    void removeNode(NodePtr node);
+
+    /**
+     * @brief 计入统计和追踪并记录移除事件，要在节点被移除之前调用
+     * @param node 节点
+     * @param cause 移除原因
      */
-    void putInternal(KeyType key, ValueType value);
+    void notifyRemoval(NodePtr node, RemovalCause cause);
 
     /**
      * @brief 获取缓存
@@ -83,10 +257,23 @@ class LFUCache : public BaseCache<KeyType, ValueType>
     void getInternal(NodePtr node, ValueType& value);
 
     /**
-     * @brief 添加到频率列表
+     * @brief 访问节点：频次加一并移动到对应的频率列表
      * @param node 节点
      */
-    void addToFreqList(NodePtr node);
+    void increaseFreq(NodePtr node);
+
+    /**
+     * @brief 取得紧跟在 prev 之后、频次为 freq 的桶，不存在时创建
+     * @param prev 前一个桶，nullptr 表示链表头部
+     * @param freq 频次
+     */
+    FreqListPtr bucketAfter(FreqListPtr prev, int freq);
+
+    /**
+     * @brief 把空桶从桶链表中摘下并回收
+     * @param bucket 空桶
+     */
+    void releaseBucket(FreqListPtr bucket);
 
     /**
      * @brief 增加平均访问等频率
@@ -95,11 +282,36 @@ class LFUCache : public BaseCache<KeyType, ValueType>
 
     /**
      * @brief 处理当前平均访问频率超过上限的情况
+     *
+     * 只推进老化纪元，不遍历节点；各节点和桶在下次被访问时结算尚未应用的衰减
      */
     void handleOverMaxAverageNum();
 
     /**
-     * @brief 更新最小频次
+     * @brief 结算节点尚未应用的衰减，并修正总频次
+     * @param node 节点
      */
-    void updateMinFreq();
-};
+    void decayNode(NodePtr node);
+
+    /**
+     * @brief 结算桶尚未应用的衰减
+     * @param bucket 频次桶
+     */
+    void decayBucket(FreqListPtr bucket);
+
+    /**
+     * @brief 老化后多个桶可能同时被截断到频次 1，每次合并一小批节点到头部桶
+     */
+    void mergeClampedBuckets();
+
+    // 过期处理，只有设置了过期时间的节点才读取时钟
+    bool         expired(NodePtr node) const;
+    std::int64_t deadline(std::int64_t ttl) const;
+    // 推进时间轮，最多清理 kExpireBatch 个过期节点
+    void expireEntries();
+
+    // 写后刷新，要求调用方已持有 mutex_
+    bool refreshDue(NodePtr node) const;
+    // 后台刷新结束：条目仍在等待这次刷新时原地替换为 value（为空表示加载失败）并清除刷新标记
+    void finishRefresh(const KeyType& key, std::size_t hash, const ValueType* value);
+};
\ No newline at end of file
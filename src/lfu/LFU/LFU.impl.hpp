@@ -2,46 +2,258 @@
 
 #include "../../utils/log.hpp"
 #include "LFU.decl.hpp"
-#include <cstdint>
+#include <algorithm>
 
-template <typename KeyType, typename ValueType>
-LFUCache<KeyType, ValueType>::LFUCache(int capacity, int maxAverageFreq)
-    : capacity_(capacity)
-    , minFreq_(INT32_MAX)
+template <typename KeyType, typename ValueType, typename Hasher>
+LFUCache<KeyType, ValueType, Hasher>::LFUCache(int capacity, int maxAverageFreq)
+    : LFUCache(capacity, maxAverageFreq, Weigher<KeyType, ValueType>{})
+{
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+LFUCache<KeyType, ValueType, Hasher>::LFUCache(std::int64_t                capacity,
+                                               int                         maxAverageFreq,
+                                               Weigher<KeyType, ValueType> weigher,
+                                               double                      admissionFraction)
+    : weights_(capacity, std::move(weigher), admissionFraction)
     , maxAverageFreq_(maxAverageFreq)
     , curAverageFreq_(0)
     , curTotalFreq_(0)
+    // 按权重计容量时条目数量未知，索引按需增长
+    , node_map_(weights_.weighted() ? 0
+                                    : static_cast<std::size_t>(std::max<std::int64_t>(capacity, 0)))
+    , pool_(static_cast<std::size_t>(std::clamp<std::int64_t>(capacity, 1, 4096)))
 {
     log("[LFU Constructor] LFUCache initialized with capacity=",
-        capacity_,
+        weights_.capacity(),
         ", maxAverageFreq=",
         maxAverageFreq_,
-        ", minFreq_=",
-        minFreq_,
         '\n');
 }
 
-template <typename KeyType, typename ValueType>
-bool LFUCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
+template <typename KeyType, typename ValueType, typename Hasher>
+LFUCache<KeyType, ValueType, Hasher>::~LFUCache()
+{
+    // 刷新任务会访问缓存的所有成员，必须在任何成员析构之前停下
+    stopRefresh();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LFUCache<KeyType, ValueType, Hasher>::get(const KeyType& key, ValueType& result)
+{
+    return getImpl(key, node_map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool LFUCache<KeyType, ValueType, Hasher>::get(const K& key, ValueType& result)
+{
+    return getImpl(key, node_map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+ValueType LFUCache<KeyType, ValueType, Hasher>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value, node_map_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value)
+{
+    std::size_t hash = node_map_.hashOf(key);
+    putImpl(std::move(key), std::move(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value,
+                                               std::chrono::milliseconds ttl)
+{
+    putImpl(key, value, node_map_.hashOf(key), ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value,
+                                               std::chrono::milliseconds ttl)
+{
+    std::size_t hash = node_map_.hashOf(key);
+    putImpl(std::move(key), std::move(value), hash, ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::setDefaultTtl(std::chrono::milliseconds ttl)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    defaultTtl_ = ttl.count();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::setRefreshAfterWrite(std::chrono::milliseconds interval)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    refreshAfter_ = std::max<std::int64_t>(interval.count(), 0);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::setRemovalListener(
+    RemovalListener<KeyType, ValueType> listener, ThreadPool* executor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    removals_.setListener(std::move(listener), executor);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+CacheStats LFUCache<KeyType, ValueType, Hasher>::stats() const
+{
+    CacheStats                  stats = this->stats_.snapshot();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.size   = node_map_.size();
+    stats.weight = weights_.used();
+    return stats;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+ValueType LFUCache<KeyType, ValueType, Hasher>::getOrLoad(const KeyType& key, Loader&& loader)
+{
+    ValueType   result{};
+    bool        stale = false;
+    std::size_t hash  = node_map_.hashOf(key);
+    if (!getImpl(key, hash, result, &stale))
+        return load(key, hash, std::forward<Loader>(loader));
+    if (stale)
+        refresh(key, hash, std::forward<Loader>(loader));
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+ValueType LFUCache<KeyType, ValueType, Hasher>::load(const KeyType& key, std::size_t hash,
+                                                     Loader&& loader)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Load);
+    return loads_.run(key,
+                      hash,
+                      [&]
+                      {
+                          // 未命中到开始加载之间，上一次加载可能刚刚写入
+                          ValueType value{};
+                          if (peekImpl(key, hash, value))
+                              return value;
+                          value = loader(key);
+                          putImpl(key, value, hash);
+                          return value;
+                      });
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+void LFUCache<KeyType, ValueType, Hasher>::refresh(const KeyType& key, std::size_t hash,
+                                                   Loader&& loader)
+{
+    bool submitted = refreshes_.submit(
+        [this, key, hash, loader = std::decay_t<Loader>(std::forward<Loader>(loader))]() mutable
+        {
+            ValueType value{};
+            try
+            {
+                value = loader(key);
+            }
+            catch (...)
+            {
+                log("[LFU refresh] Load failed for key: ", key, '\n');
+                finishRefresh(key, hash, nullptr);
+                return;
+            }
+            finishRefresh(key, hash, &value);
+        });
+    // 线程池忙时放弃本次刷新，清除标记让之后的命中重新尝试
+    if (!submitted)
+        finishRefresh(key, hash, nullptr);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::stopRefresh()
+{
+    refreshes_.close();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LFUCache<KeyType, ValueType, Hasher>::peek(const KeyType& key, ValueType& result) const
+{
+    return peekImpl(key, node_map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool LFUCache<KeyType, ValueType, Hasher>::peek(const K& key, ValueType& result) const
+{
+    return peekImpl(key, node_map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LFUCache<KeyType, ValueType, Hasher>::contains(const KeyType& key) const
+{
+    return containsImpl(key, node_map_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool LFUCache<KeyType, ValueType, Hasher>::contains(const K& key) const
+{
+    return containsImpl(key, node_map_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool LFUCache<KeyType, ValueType, Hasher>::getImpl(const K& key, std::size_t hash,
+                                                   ValueType& result, bool* stale)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::GetMiss);
+    WriteLock    lock(mutex_, removals_);
+    expireEntries();
 
     log("[LFU get] Looking for key: ", key, '\n');
 
-    auto it = node_map_.find(key);
-    if (it == node_map_.end())
+    NodePtr* slot = node_map_.find(key, hash);
+    if (!slot)
     {
+        this->stats_.miss();
+        this->trace(TraceOp::GetMiss, hash);
         log("[LFU get] Key not found: ", key, '\n');
         return false;
     }
 
-    NodePtr node = it->second;
+    NodePtr node = *slot;
     if (!node)
     {
+        this->stats_.miss();
+        this->trace(TraceOp::GetMiss, hash);
         log("[LFU get] Node is null for key: ", key, '\n');
         return false;
     }
 
+    if (expired(node))
+    {
+        // 惰性过期：时间轮还没推进到的过期节点在查找时直接移除
+        log("[LFU get] Key expired: ", key, '\n');
+        notifyRemoval(node, RemovalCause::Expired);
+        removeNode(node);
+        this->stats_.miss();
+        this->trace(TraceOp::GetMiss, hash);
+        return false;
+    }
+    this->stats_.hit();
+    this->trace(TraceOp::GetHit, hash);
+    timing.setOp(LatencyOp::GetHit);
+
     log("[LFU get] Found key: ",
         key,
         ", current freq: ",
@@ -51,6 +263,11 @@ bool LFUCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
         '\n');
 
     getInternal(node, result);
+    if (stale && refreshDue(node))
+    {
+        meta_.setRefreshing(node, true);
+        *stale = true;
+    }
 
     log("[LFU get] Successfully retrieved key: ",
         key,
@@ -63,133 +280,306 @@ bool LFUCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
     return true;
 }
 
-template <typename KeyType, typename ValueType>
-ValueType LFUCache<KeyType, ValueType>::get(KeyType key)
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool LFUCache<KeyType, ValueType, Hasher>::peekImpl(const K& key, std::size_t hash,
+                                                    ValueType& result) const
 {
-    ValueType result{};
-    get(key, result);
-    return result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    const NodePtr*              slot = node_map_.find(key, hash);
+    if (slot && !expired(*slot))
+    {
+        result = (*slot)->value;
+        return true;
+    }
+    return false;
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::put(KeyType key, ValueType value)
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool LFUCache<KeyType, ValueType, Hasher>::containsImpl(const K& key, std::size_t hash) const
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    const NodePtr*              slot = node_map_.find(key, hash);
+    return slot && !expired(*slot);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LFUCache<KeyType, ValueType, Hasher>::putImpl(K&& key, V&& value, std::size_t hash)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Put);
+    WriteLock    lock(mutex_, removals_);
+    putLocked(std::forward<K>(key), std::forward<V>(value), hash, deadline(defaultTtl_));
+}
 
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LFUCache<KeyType, ValueType, Hasher>::putImpl(K&& key, V&& value, std::size_t hash,
+                                                   std::chrono::milliseconds ttl)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Put);
+    WriteLock    lock(mutex_, removals_);
+    putLocked(std::forward<K>(key), std::forward<V>(value), hash, deadline(ttl.count()));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LFUCache<KeyType, ValueType, Hasher>::putLocked(K&& key, V&& value, std::size_t hash,
+                                                     std::int64_t expireAt)
+{
     log("[LFU put] Inserting key: ", key, ", value: ", value, '\n');
+    expireEntries();
+    this->stats_.put();
 
+    std::int64_t weight = weights_.weigh(key, value);
     // 检查是否已存在
-    auto it = node_map_.find(key);
-    if (it != node_map_.end())
+    if (NodePtr* slot = node_map_.find(key, hash))
     {
-        NodePtr node = it->second;
+        NodePtr node = *slot;
+        if (node && !weights_.admits(weight))
+        {
+            // 新值过大不能写入，也不能留下已过期的旧值
+            log("[LFU put] Rejected key: ", key, ", weight: ", weight, '\n');
+            notifyRemoval(node, RemovalCause::Size);
+            removeNode(node);
+            return;
+        }
         if (node)
         {
-            ValueType old_value{};
-            getInternal(node, old_value);
             log("[LFU put] Key already exists: ",
                 key,
                 ", ",
-                old_value,
+                node->value,
                 "->",
                 value,
                 ", freq: ",
                 node->freq,
                 '\n');
 
-            node->value = value;
+            notifyRemoval(node, RemovalCause::Replaced);
+            weights_.charge(weight - meta_.weightOf(node));
+            node->value = std::forward<V>(value);
+            increaseFreq(node);
+            // 正在进行的刷新结果比这次写入旧，完成时丢弃
+            meta_.assign(node, weight, refreshAfter_ > 0 ? CoarseClock::now() : 0, expireAt);
+
+            // 新值变重时继续按频次淘汰，直到总权重回到容量以内
+            while (!node_map_.empty() && weights_.overflows(0)) removeLast();
             return;
         }
 
         log("[LFU put] Node is null for key: ", key, '\n');
     }
 
-    log("[LFU put] Key is new, current size: ", node_map_.size(), "/", capacity_, '\n');
+    if (!weights_.admits(weight))
+    {
+        this->trace(TraceOp::Reject, hash);
+        log("[LFU put] Rejected key: ", key, ", weight: ", weight, '\n');
+        return;
+    }
+    this->trace(TraceOp::Insert, hash);
 
-    putInternal(key, value);
+    log("[LFU put] Key is new, current size: ",
+        node_map_.size(),
+        "/",
+        weights_.capacity(),
+        '\n');
 
-    log("[LFU put] Successfully inserted key: ",
-        key,
-        ", final size: ",
+    putInternal(std::forward<K>(key), std::forward<V>(value), hash, weight, expireAt);
+
+    log("[LFU put] Successfully inserted new key, final size: ",
         node_map_.size(),
         "/",
-        capacity_,
+        weights_.capacity(),
         '\n');
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::purge()
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t LFUCache<KeyType, ValueType, Hasher>::getMany(const KeyType* keys,
+                                                          std::size_t    count,
+                                                          ValueType*     results,
+                                                          std::uint64_t* hitBits)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    node_map_.clear();
-    freq_map_.clear();
+    this->clearHitBits(hitBits, count);
+    return getManyAt(keys, nullptr, nullptr, count, results, hitBits);
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::changeCapacity(int num)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::putMany(const KeyType* keys, const ValueType* values,
+                                                   std::size_t count)
 {
-    capacity_ += num;
+    putManyAt(keys, values, nullptr, nullptr, count);
+}
 
-    // 确保容量不会变为0或负数
-    if (capacity_ < 1)
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t LFUCache<KeyType, ValueType, Hasher>::getManyAt(const KeyType*       keys,
+                                                            const std::size_t*   hashes,
+                                                            const std::uint32_t* positions,
+                                                            std::size_t          count,
+                                                            ValueType*           results,
+                                                            std::uint64_t*       hitBits)
+{
+    std::size_t hits = 0;
+    WriteLock   lock(mutex_, removals_);
+    expireEntries();
+    for (std::size_t n = 0; n < count; n++)
     {
-        capacity_ = 1;
+        std::size_t i    = positions ? positions[n] : n;
+        std::size_t hash = hashes ? hashes[i] : node_map_.hashOf(keys[i]);
+        NodePtr*    slot = node_map_.find(keys[i], hash);
+        if (!slot)
+        {
+            this->trace(TraceOp::GetMiss, hash);
+            continue;
+        }
+        if (expired(*slot))
+        {
+            notifyRemoval(*slot, RemovalCause::Expired);
+            removeNode(*slot);
+            this->trace(TraceOp::GetMiss, hash);
+            continue;
+        }
+        this->trace(TraceOp::GetHit, hash);
+        getInternal(*slot, results[i]);
+        this->setHitBit(hitBits, i);
+        hits++;
     }
+    this->stats_.hit(hits);
+    this->stats_.miss(count - hits);
+    return hits;
+}
 
-    // 只有当确实有超出容量的节点时才移除
-    while (node_map_.size() > capacity_ && !node_map_.empty()) { removeLast(); }
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::putManyAt(const KeyType*       keys,
+                                                     const ValueType*     values,
+                                                     const std::size_t*   hashes,
+                                                     const std::uint32_t* positions,
+                                                     std::size_t          count)
+{
+    WriteLock lock(mutex_, removals_);
+    for (std::size_t n = 0; n < count; n++)
+    {
+        std::size_t i = positions ? positions[n] : n;
+        std::size_t hash = hashes ? hashes[i] : node_map_.hashOf(keys[i]);
+        putLocked(keys[i], values[i], hash, deadline(defaultTtl_));
+    }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::purge()
+{
+    WriteLock lock(mutex_, removals_);
+    if (removals_.enabled() || this->stats_.enabled() || kTraceEnabled)
+    {
+        node_map_.forEach([this](const KeyType&, NodePtr node)
+                          { notifyRemoval(node, RemovalCause::Explicit); });
+    }
+    node_map_.clear();
+    freqHead_ = nullptr;
+    buckets_.clear();
+    freeBuckets_.clear();
+    pool_.clear();
+    meta_.clear();
+    weights_.clear();
+    curTotalFreq_   = 0;
+    curAverageFreq_ = 0;
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::putInternal(KeyType key, ValueType value)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::changeCapacity(std::int64_t num)
+{
+    WriteLock lock(mutex_, removals_);
+    // 容量不会变为0或负数
+    weights_.resize(num);
+
+    // 只有当确实超出容量时才移除
+    while (!node_map_.empty() && weights_.overflows(0)) { removeLast(); }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::putInternal(KeyType key, ValueType value,
+                                                       std::size_t hash, std::int64_t weight,
+                                                       std::int64_t expireAt)
 {
     log("[LFU putInternal] Adding new key: ", key, ", value: ", value, '\n');
 
-    if (node_map_.size() >= capacity_)
+    // 淘汰到能容纳新节点为止，remove 会归还被淘汰节点的权重
+    while (!node_map_.empty() && weights_.overflows(weight))
     {
         log("[LFU putInternal] Cache is full (",
-            node_map_.size(),
+            weights_.used(),
             "/",
-            capacity_,
+            weights_.capacity(),
             "), need to evict\n");
         removeLast();
     }
 
+    mergeClampedBuckets();
+
     log("[LFU putInternal] Creating new node for key: ", key, '\n');
-    NodePtr node   = std::make_shared<NodeType>(key, value);
-    node_map_[key] = node;
+    NodePtr node = pool_.acquire();
+    node->key    = std::move(key);
+    node->value  = std::move(value);
+    node->freq   = 1;
+    node->epoch  = agingEpoch_;
+    node->hash   = hash;
+    node_map_.insert(hash, node);
+    weights_.charge(weight);
     addTotalFreq();
-    addToFreqList(node);
-    minFreq_ = std::min(minFreq_, 1);
+    // 平均频次超限的处理可能改变桶链表，放在取桶之前
+    bucketAfter(nullptr, 1)->addNode(node);
+    meta_.assign(node, weight, refreshAfter_ > 0 ? CoarseClock::now() : 0, expireAt);
 
     log("[LFU putInternal] Successfully added key: ",
-        key,
+        node->key,
         ", current size: ",
         node_map_.size(),
         "/",
-        capacity_,
-        ", min_freq: ",
-        minFreq_,
+        weights_.capacity(),
         '\n');
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::getInternal(NodePtr node, ValueType& value)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::getInternal(NodePtr node, ValueType& value)
 {
-    value        = node->value;
+    value = node->value;
+    increaseFreq(node);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::increaseFreq(NodePtr node)
+{
+    mergeClampedBuckets();
+    decayNode(node);
+
     int old_freq = node->freq;
 
-    log("[LFU getInternal] Processing access for key: ",
+    log("[LFU increaseFreq] Processing access for key: ",
         node->key,
         ", old freq: ",
         old_freq,
-        ", value: ",
-        value,
         '\n');
 
-    remove(node);
+    FreqListPtr bucket = node->bucket;
+    decayBucket(bucket);
+    if (bucket->next_)
+        decayBucket(bucket->next_);
+
     node->freq++;
-    addToFreqList(node);
+    if (bucket->head_.next == node && node->next == &bucket->tail_ &&
+        (!bucket->next_ || bucket->next_->freq_ > node->freq))
+    {
+        // 桶里只有这一个节点，且下一个桶的频次更高：直接提升桶的频次，无需移动节点
+        bucket->freq_ = node->freq;
+    }
+    else
+    {
+        // 先取得目标桶，原桶移空后才会被回收
+        FreqListPtr target = bucketAfter(bucket, node->freq);
+        remove(node);
+        target->addNode(node);
+    }
 
     // 更新总频次（访问时频次增加1）
     curTotalFreq_++;
@@ -199,7 +589,7 @@ void LFUCache<KeyType, ValueType>::getInternal(NodePtr node, ValueType& value)
     else
         curAverageFreq_ = curTotalFreq_ / static_cast<int>(node_map_.size());
 
-    log("[LFU getInternal] Updated frequency for key: ",
+    log("[LFU increaseFreq] Updated frequency for key: ",
         node->key,
         " from ",
         old_freq,
@@ -216,37 +606,28 @@ void LFUCache<KeyType, ValueType>::getInternal(NodePtr node, ValueType& value)
     // 检查是否超过最大平均频次
     if (curAverageFreq_ > maxAverageFreq_)
     {
-        log("[LFU getInternal] Average freq (",
+        log("[LFU increaseFreq] Average freq (",
             curAverageFreq_,
             ") exceeds max (",
             maxAverageFreq_,
             "), handling overflow\n");
         handleOverMaxAverageNum();
     }
-
-    // 若现在 freq = minFreq_+1 且无 minFreq_的 node 了，更新 minFreq_
-    if (node->freq == minFreq_ + 1 && freq_map_[minFreq_]->empty())
-    {
-        int old_min_freq = minFreq_;
-        minFreq_++;
-        log("[LFU getInternal] Updated min_freq from ",
-            old_min_freq,
-            " to ",
-            minFreq_,
-            " (no nodes at old min_freq)\n");
-    }
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::removeLast()
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::removeLast()
 {
     if (node_map_.empty())
     {
         log("[LFU removeLast] No node to evict!\n");
         return;
     }
+    LatencyScope timing(this->latency_.get(), LatencyOp::Evict);
 
-    log("[LFU removeLast] Evicting least frequently used node, min_freq: ", minFreq_, '\n');
+    log("[LFU removeLast] Evicting least frequently used node, min_freq: ",
+        freqHead_ ? freqHead_->freq_ : 0,
+        '\n');
 
     auto node = getLastNode();
     if (!node)
@@ -263,27 +644,35 @@ void LFUCache<KeyType, ValueType>::removeLast()
         node->value,
         '\n');
 
+    // 节点移除后会被节点池回收重置，先保存需要的字段
+    int freq = node->freq;
+    notifyRemoval(node, RemovalCause::Size);
     remove(node, true);
 
-    decreaseTotalFreq(node->freq);
+    decreaseTotalFreq(freq);
 
-    log("[LFU removeLast] Successfully evicted key: ",
-        node->key,
-        ", new size: ",
+    log("[LFU removeLast] Successfully evicted node, new size: ",
         node_map_.size(),
         "/",
-        capacity_,
+        weights_.capacity(),
         '\n');
 }
 
-template <typename KeyType, typename ValueType>
-typename LFUCache<KeyType, ValueType>::NodePtr LFUCache<KeyType, ValueType>::getLastNode()
+template <typename KeyType, typename ValueType, typename Hasher>
+typename LFUCache<KeyType, ValueType, Hasher>::NodePtr
+LFUCache<KeyType, ValueType, Hasher>::getLastNode()
 {
-    return freq_map_[minFreq_]->getEarliestNode();
+    if (!freqHead_)
+        return nullptr;
+
+    // 淘汰前结算衰减，调用方读到的 freq 才是准确的
+    NodePtr node = freqHead_->getEarliestNode();
+    decayNode(node);
+    return node;
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::remove(NodePtr& node, bool removeMap)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::remove(NodePtr node, bool removeMap)
 {
     if (!node)
         return;
@@ -291,48 +680,92 @@ void LFUCache<KeyType, ValueType>::remove(NodePtr& node, bool removeMap)
     int freq = node->freq;
     log("[LFU remove] Removing node with key: ", node->key, " from freq list: ", freq, '\n');
 
-    // 检查频率列表是否存在
-    if (freq_map_.find(freq) != freq_map_.end())
+    FreqListPtr bucket = node->bucket;
+    if (bucket)
     {
-        freq_map_[freq]->removeNode(node);
+        bucket->removeNode(node);
+        // 空桶立即回收，桶链表中不保留空桶
+        if (bucket->empty())
+            releaseBucket(bucket);
     }
 
-    if (removeMap)
-        node_map_.erase(node->key);
-
     log("[LFU remove] Successfully removed node with key: ",
         node->key,
         " from freq list: ",
         freq,
         '\n');
+
+    if (removeMap)
+    {
+        weights_.discharge(meta_.release(node));
+        node_map_.erase(node->key, node->hash);
+        pool_.release(node);
+    }
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::addToFreqList(NodePtr node)
+template <typename KeyType, typename ValueType, typename Hasher>
+typename LFUCache<KeyType, ValueType, Hasher>::FreqListPtr
+LFUCache<KeyType, ValueType, Hasher>::bucketAfter(FreqListPtr prev, int freq)
 {
-    if (!node)
-        return;
+    FreqListPtr next = prev ? prev->next_ : freqHead_;
+    // 老化截断可能留下多个频次相同的桶，跳过频次更低的桶
+    while (next)
+    {
+        decayBucket(next);
+        if (next->freq_ >= freq)
+            break;
+        prev = next;
+        next = next->next_;
+    }
+    if (next && next->freq_ == freq)
+        return next;
 
-    int freq = node->freq;
-    log("[LFU addToFreqList] Adding node with key: ", node->key, " to freq list: ", freq, '\n');
+    log("[LFU bucketAfter] Creating freq list: ", freq, '\n');
 
-    // 如果频率列表不存在，创建一个新的
-    if (freq_map_.find(freq) == freq_map_.end())
+    FreqListPtr bucket;
+    if (!freeBuckets_.empty())
     {
-        freq_map_[freq] = std::make_unique<FreqList<KeyType, ValueType>>(freq);
+        bucket = freeBuckets_.back();
+        freeBuckets_.pop_back();
+    }
+    else
+    {
+        buckets_.emplace_back(std::make_unique<FreqListType>());
+        bucket = buckets_.back().get();
     }
 
-    freq_map_[freq]->addNode(node);
+    bucket->freq_  = freq;
+    bucket->epoch_ = agingEpoch_;
+    bucket->prev_  = prev;
+    bucket->next_  = next;
+    if (prev)
+        prev->next_ = bucket;
+    else
+        freqHead_ = bucket;
+    if (next)
+        next->prev_ = bucket;
+    return bucket;
+}
 
-    log("[LFU addToFreqList] Successfully added node with key: ",
-        node->key,
-        " to freq list: ",
-        freq,
-        '\n');
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::releaseBucket(FreqListPtr bucket)
+{
+    log("[LFU releaseBucket] Releasing empty freq list: ", bucket->freq_, '\n');
+
+    if (bucket->prev_)
+        bucket->prev_->next_ = bucket->next_;
+    else
+        freqHead_ = bucket->next_;
+    if (bucket->next_)
+        bucket->next_->prev_ = bucket->prev_;
+
+    bucket->prev_ = nullptr;
+    bucket->next_ = nullptr;
+    freeBuckets_.push_back(bucket);
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::addTotalFreq()
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::addTotalFreq()
 {
     // 新添加节点，频次为1
     curTotalFreq_ += 1;
@@ -361,8 +794,8 @@ void LFUCache<KeyType, ValueType>::addTotalFreq()
     }
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::decreaseTotalFreq(int num)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::decreaseTotalFreq(int num)
 {
     int old_total = curTotalFreq_;
     curTotalFreq_ -= num;
@@ -386,50 +819,19 @@ void LFUCache<KeyType, ValueType>::decreaseTotalFreq(int num)
         '\n');
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::handleOverMaxAverageNum()
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::handleOverMaxAverageNum()
 {
-    int reduction = maxAverageFreq_ / 2;
+    LatencyScope timing(this->latency_.get(), LatencyOp::Maintenance);
+    int          reduction = maxAverageFreq_ / 2;
     log("[LFU handleOverMaxAverageNum] Handling frequency overflow, reducing all frequencies by ",
         reduction,
         '\n');
 
-    // 重新计算总频次
-    curTotalFreq_ = 0;
-
-    for (auto it = node_map_.begin(); it != node_map_.end(); ++it)
-    {
-        // node 不存在，跳过
-        if (!it->second)
-            continue;
-
-        NodePtr node     = it->second;
-        int     old_freq = node->freq;
-
-        log("[LFU handleOverMaxAverageNum] Processing key: ",
-            node->key,
-            ", old freq: ",
-            old_freq,
-            '\n');
-
-        remove(node);
-
-        node->freq -= reduction;
-        node->freq = std::max(node->freq, 1);
-
-        addToFreqList(node);
-
-        // 累计新的总频次
-        curTotalFreq_ += node->freq;
-
-        log("[LFU handleOverMaxAverageNum] Updated key: ",
-            node->key,
-            " freq: ",
-            old_freq,
-            " -> ",
-            node->freq,
-            '\n');
-    }
+    // 推进纪元即可，节点和桶在下次被访问时才结算衰减，避免一次遍历全部节点。
+    // 总频次先按每个节点都衰减 reduction 扣除，被截断到 1 的节点在结算时补回差值
+    agingEpoch_++;
+    curTotalFreq_ -= reduction * static_cast<int>(node_map_.size());
 
     // 更新平均频次
     if (node_map_.empty())
@@ -442,32 +844,149 @@ void LFUCache<KeyType, ValueType>::handleOverMaxAverageNum()
         ", average freq: ",
         curAverageFreq_,
         '\n');
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::decayNode(NodePtr node)
+{
+    std::uint32_t pending = agingEpoch_ - node->epoch;
+    if (pending == 0)
+        return;
+
+    // 多次"减去 reduction 并截断到 1"等价于一次减去 reduction * pending 再截断
+    long long assumed  = static_cast<long long>(maxAverageFreq_ / 2) * pending;
+    int       new_freq = static_cast<int>(std::max<long long>(node->freq - assumed, 1));
+    curTotalFreq_ += static_cast<int>(assumed - (node->freq - new_freq));
 
-    updateMinFreq();
+    log("[LFU decayNode] Key: ", node->key, " freq: ", node->freq, " -> ", new_freq, '\n');
+
+    node->freq  = new_freq;
+    node->epoch = agingEpoch_;
 }
 
-template <typename KeyType, typename ValueType>
-void LFUCache<KeyType, ValueType>::updateMinFreq()
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::decayBucket(FreqListPtr bucket)
 {
-    int old_min_freq = minFreq_;
-    minFreq_         = INT32_MAX;
+    std::uint32_t pending = agingEpoch_ - bucket->epoch_;
+    if (pending == 0)
+        return;
+
+    long long assumed = static_cast<long long>(maxAverageFreq_ / 2) * pending;
+    bucket->freq_     = static_cast<int>(std::max<long long>(bucket->freq_ - assumed, 1));
+    bucket->epoch_    = agingEpoch_;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::mergeClampedBuckets()
+{
+    if (!freqHead_ || !freqHead_->next_)
+        return;
 
-    log("[LFU updateMinFreq] Updating min_freq, current: ", old_min_freq, '\n');
+    // 衰减保持桶的顺序，只有被截断的桶会与头部桶频次相同
+    FreqListPtr head = freqHead_;
+    FreqListPtr next = head->next_;
+    decayBucket(head);
+    decayBucket(next);
+    if (next->freq_ != head->freq_)
+        return;
 
-    for (auto it = freq_map_.begin(); it != freq_map_.end(); ++it)
+    // 从最早的节点开始移到头部桶的前端，保持先后顺序
+    for (int i = 0; i < kMergeSlice; i++)
     {
-        if (!it->second->empty())
-        {
-            minFreq_ = std::min(minFreq_, it->first);
-            log("[LFU updateMinFreq] Found non-empty freq list: ", it->first, '\n');
-        }
+        NodePtr node = next->getEarliestNode();
+        if (!node)
+            break;
+        next->removeNode(node);
+        decayNode(node);
+        head->addNode(node);
     }
 
-    if (minFreq_ == INT32_MAX)
+    if (next->empty())
+        releaseBucket(next);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::removeNode(NodePtr node)
+{
+    decayNode(node);
+    int freq = node->freq;
+    remove(node, true);
+    decreaseTotalFreq(freq);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::notifyRemoval(NodePtr node, RemovalCause cause)
+{
+    this->stats_.removal(cause);
+    this->trace(cause, node->hash);
+    removals_.record(node->key, std::move(node->value), cause);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LFUCache<KeyType, ValueType, Hasher>::expired(NodePtr node) const
+{
+    return meta_.expired(node);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::int64_t LFUCache<KeyType, ValueType, Hasher>::deadline(std::int64_t ttl) const
+{
+    return ttl > 0 ? CoarseClock::now() + ttl : 0;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::expireEntries()
+{
+    if (meta_.timersEmpty())
+        return;
+    LatencyScope timing(this->latency_.get(), LatencyOp::Maintenance);
+    std::size_t  expired = meta_.expire(CoarseClock::now(),
+                                        kExpireBatch,
+                                        [this](NodePtr node)
+                                        {
+                                            notifyRemoval(node, RemovalCause::Expired);
+                                            removeNode(node);
+                                        });
+    // 没有节点过期的推进不计入维护延迟
+    if (expired == 0)
+        timing.dismiss();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LFUCache<KeyType, ValueType, Hasher>::refreshDue(NodePtr node) const
+{
+    return refreshAfter_ > 0 && meta_.refreshDue(node, refreshAfter_);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LFUCache<KeyType, ValueType, Hasher>::finishRefresh(const KeyType& key, std::size_t hash,
+                                                         const ValueType* value)
+{
+    WriteLock lock(mutex_, removals_);
+    NodePtr*  slot = node_map_.find(key, hash);
+    // 刷新期间条目被淘汰（附加记录随节点回收）或被重新写入，这次刷新已经过时
+    if (!slot || !meta_.refreshing(*slot))
+        return;
+    NodePtr node = *slot;
+    if (!value)
     {
-        minFreq_ = 1;
-        log("[LFU updateMinFreq] No non-empty freq lists found, setting min_freq to 1\n");
+        meta_.setRefreshing(node, false);
+        return;
     }
-    else
-        log("[LFU updateMinFreq] Updated min_freq from ", old_min_freq, " to ", minFreq_, '\n');
+
+    // 刷新不是用户访问：只替换值，过期时刻和频次不变，不计入写入也不产生覆盖事件
+    std::int64_t weight = weights_.weigh(key, *value);
+    if (!weights_.admits(weight))
+    {
+        log("[LFU refresh] Rejected key: ", key, ", weight: ", weight, '\n');
+        notifyRemoval(node, RemovalCause::Size);
+        removeNode(node);
+        return;
+    }
+    weights_.charge(weight - meta_.weightOf(node));
+    node->value = *value;
+    meta_.refreshed(node, weight, refreshAfter_ > 0 ? CoarseClock::now() : 0);
+
+    // 新值变重时继续按频次淘汰，节点自身也可能被淘汰
+    while (!node_map_.empty() && weights_.overflows(0)) removeLast();
 }
\ No newline at end of file
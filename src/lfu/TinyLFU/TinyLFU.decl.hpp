@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../../common/BaseCache.hpp"
+#include "../../common/BloomFilter.hpp"
+#include "../../common/CountMinSketch.hpp"
+#include "../../common/FlatMap.hpp"
+#include "../../common/IntrusiveList.hpp"
+#include "../../common/Node.hpp"
+#include "../../common/NodePool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief W-TinyLFU 缓存
+ *
+ * 新条目先进入容量约为 1% 的窗口 LRU；被挤出窗口的候选者只有在估计频次高于主区的淘汰者时才被准入。
+ * 主区是分段 LRU：准入的条目进入试用段，试用段再次命中后晋升到保护段（约占主区 80%）。
+ * 频次由 4 位计数器的 Count-Min Sketch 估计，只出现过一次的键由门卫布隆过滤器记录，不占用计数器；
+ * 记录次数达到采样上限（容量的 10 倍）后计数器减半、门卫清空，使旧的热点逐渐失效。
+ */
+template <typename KeyType, typename ValueType>
+class TinyLFUCache : public BaseCache<KeyType, ValueType>
+{
+    using NodeType = Node<KeyType, ValueType>;
+    using NodePtr  = NodeType*;
+
+    enum class Segment : std::uint8_t
+    {
+        Window,    // 窗口 LRU
+        Probation, // 主区试用段
+        Protected, // 主区保护段
+    };
+
+    struct Entry
+    {
+        NodePtr node{nullptr};
+        Segment segment{Segment::Window};
+    };
+
+    // 索引的取键方式：键只存放在节点中
+    struct EntryKey
+    {
+        const KeyType& operator()(const Entry& entry) const { return entry.node->key; }
+    };
+
+    using EntryMap = FlatMap<KeyType, Entry, DefaultHash<KeyType>, std::equal_to<>, EntryKey>;
+
+    int capacity_;          // 总容量
+    int windowCapacity_;    // 窗口容量
+    int protectedCapacity_; // 保护段容量
+    int sampleSize_;        // 计数器减半前的记录次数
+    int samples_{};         // 当前记录次数
+
+    IntrusiveList<NodeType> window_;
+    IntrusiveList<NodeType> probation_;
+    IntrusiveList<NodeType> protected_;
+    EntryMap                index_;      // key->节点及所在段
+    NodePool<NodeType>      pool_;       // 节点池，淘汰的节点回收复用
+    CountMinSketch          sketch_;     // 频次估计
+    BloomFilter             doorkeeper_; // 门卫：记录只出现过一次的键
+    mutable std::mutex      mutex_;      // 命中也会调整链表和计数器，使用互斥锁
+
+  public:
+    TinyLFUCache(int capacity);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    // evictions 包括窗口候选者被拒绝准入的次数
+    CacheStats stats() const override;
+
+  private:
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value);
+
+    /**
+     * @brief 记录一次访问：首次出现只记入门卫，之后才累加计数器
+     */
+    void recordAccess(std::size_t hash);
+
+    /**
+     * @brief 估计键的访问频次
+     */
+    int frequency(std::size_t hash) const;
+
+    /**
+     * @brief 命中后按所在段调整位置
+     */
+    void onHit(Entry& entry);
+
+    /**
+     * @brief 窗口超出容量时，把窗口尾部的候选者与主区淘汰者比较，决定淘汰哪一个
+     */
+    void evictFromWindow();
+
+    /**
+     * @brief 修改节点记录的所在段
+     */
+    void setSegment(NodePtr node, Segment segment);
+
+    /**
+     * @brief 从索引中删除节点并回收（调用方已把节点移出链表）
+     */
+    void release(NodePtr node);
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "TinyLFU.decl.hpp"
+#include "TinyLFU.impl.hpp"
\ No newline at end of file
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "../../utils/log.hpp"
+#include "TinyLFU.decl.hpp"
+#include <algorithm>
+
+template <typename KeyType, typename ValueType>
+TinyLFUCache<KeyType, ValueType>::TinyLFUCache(int capacity)
+    : capacity_(std::max(capacity, 1))
+    , windowCapacity_(std::max(capacity_ / 100, 1))
+    , protectedCapacity_((capacity_ - windowCapacity_) * 4 / 5)
+    , sampleSize_(capacity_ * 10)
+    , index_(capacity_ + 1)
+    , pool_(std::clamp(capacity_, 1, 4096))
+    , sketch_(capacity_)
+    , doorkeeper_(static_cast<std::size_t>(capacity_) * 8)
+{
+}
+
+template <typename KeyType, typename ValueType>
+bool TinyLFUCache<KeyType, ValueType>::get(const KeyType& key, ValueType& result)
+{
+    LatencyScope                timing(this->latency_.get(), LatencyOp::GetMiss);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t                 hash = index_.hashOf(key);
+    recordAccess(hash);
+
+    Entry* entry = index_.find(key, hash);
+    if (!entry)
+    {
+        this->stats_.miss();
+        log("(TinyLFU get) get failed: ", key, '\n');
+        return false;
+    }
+    this->stats_.hit();
+    timing.setOp(LatencyOp::GetHit);
+
+    onHit(*entry);
+    result = entry->node->value;
+    log("(TinyLFU get) get: ", key, " = ", result, '\n');
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType TinyLFUCache<KeyType, ValueType>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::put(KeyType&& key, ValueType&& value)
+{
+    putImpl(std::move(key), std::move(value));
+}
+
+template <typename KeyType, typename ValueType>
+bool TinyLFUCache<KeyType, ValueType>::peek(const KeyType& key, ValueType& result) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const Entry* entry = index_.find(key))
+    {
+        result = entry->node->value;
+        return true;
+    }
+    return false;
+}
+
+template <typename KeyType, typename ValueType>
+bool TinyLFUCache<KeyType, ValueType>::contains(const KeyType& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.contains(key);
+}
+
+template <typename KeyType, typename ValueType>
+CacheStats TinyLFUCache<KeyType, ValueType>::stats() const
+{
+    CacheStats                  stats = this->stats_.snapshot();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.size   = static_cast<std::size_t>(window_.size() + probation_.size() + protected_.size());
+    stats.weight = static_cast<std::int64_t>(stats.size);
+    return stats;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K, typename V>
+void TinyLFUCache<KeyType, ValueType>::putImpl(K&& key, V&& value)
+{
+    LatencyScope                timing(this->latency_.get(), LatencyOp::Put);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t                 hash = index_.hashOf(key);
+    recordAccess(hash);
+    this->stats_.put();
+
+    if (Entry* entry = index_.find(key, hash))
+    {
+        this->stats_.removal(RemovalCause::Replaced);
+        entry->node->value = std::forward<V>(value);
+        log("(TinyLFU put) update: ", key, '=', entry->node->value, '\n');
+        onHit(*entry);
+        return;
+    }
+    log("(TinyLFU put) new put: ", key, '=', value, '\n');
+
+    // 新条目总是先进入窗口
+    NodePtr node = pool_.acquire();
+    node->key    = std::forward<K>(key);
+    node->value  = std::forward<V>(value);
+    node->hash   = hash;
+    index_.insert(hash, Entry{node, Segment::Window});
+    window_.pushFront(node);
+
+    if (window_.size() > windowCapacity_)
+        evictFromWindow();
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::recordAccess(std::size_t hash)
+{
+    // 门卫过滤只出现一次的键，第二次出现才累加计数器
+    if (doorkeeper_.put(hash))
+        sketch_.increment(hash);
+
+    if (++samples_ >= sampleSize_)
+    {
+        LatencyScope timing(this->latency_.get(), LatencyOp::Maintenance);
+        log("(TinyLFU) reset sketch after ", samples_, " samples\n");
+        sketch_.halve();
+        doorkeeper_.clear();
+        samples_ /= 2;
+    }
+}
+
+template <typename KeyType, typename ValueType>
+int TinyLFUCache<KeyType, ValueType>::frequency(std::size_t hash) const
+{
+    return sketch_.estimate(hash) + (doorkeeper_.contains(hash) ? 1 : 0);
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::onHit(Entry& entry)
+{
+    NodePtr node = entry.node;
+    switch (entry.segment)
+    {
+    case Segment::Window:
+        window_.moveToFront(node);
+        break;
+    case Segment::Probation:
+        // 试用段再次命中，晋升到保护段；保护段超出容量时把最久未访问的条目降回试用段
+        probation_.unlink(node);
+        protected_.pushFront(node);
+        entry.segment = Segment::Protected;
+        if (protected_.size() > protectedCapacity_)
+        {
+            NodePtr demoted = protected_.back();
+            protected_.unlink(demoted);
+            probation_.pushFront(demoted);
+            setSegment(demoted, Segment::Probation);
+        }
+        break;
+    case Segment::Protected:
+        protected_.moveToFront(node);
+        break;
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::evictFromWindow()
+{
+    NodePtr candidate = window_.back();
+    window_.unlink(candidate);
+
+    // 主区未满，直接准入
+    if (probation_.size() + protected_.size() < capacity_ - windowCapacity_)
+    {
+        probation_.pushFront(candidate);
+        setSegment(candidate, Segment::Probation);
+        return;
+    }
+
+    // 主区已满，淘汰者或候选者必有一个离开缓存
+    LatencyScope timing(this->latency_.get(), LatencyOp::Evict);
+    this->stats_.removal(RemovalCause::Size);
+
+    // 淘汰者优先取试用段尾部
+    IntrusiveList<NodeType>* victimList = probation_.empty() ? &protected_ : &probation_;
+    NodePtr                  victim     = victimList->back();
+    if (victim && frequency(candidate->hash) > frequency(victim->hash))
+    {
+        log("(TinyLFU) admit ", candidate->key, ", evict ", victim->key, '\n');
+        victimList->unlink(victim);
+        release(victim);
+        probation_.pushFront(candidate);
+        setSegment(candidate, Segment::Probation);
+    }
+    else
+    {
+        log("(TinyLFU) reject ", candidate->key, '\n');
+        release(candidate);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::setSegment(NodePtr node, Segment segment)
+{
+    index_.find(node->key, node->hash)->segment = segment;
+}
+
+template <typename KeyType, typename ValueType>
+void TinyLFUCache<KeyType, ValueType>::release(NodePtr node)
+{
+    index_.erase(node->key, node->hash);
+    pool_.release(node);
+}
@@ -1,2 +1,3 @@
 #include "LFU/LFU.hpp"
-#include "HashLFU/HashLFU.hpp"
\ No newline at end of file
+#include "HashLFU/HashLFU.hpp"
+#include "TinyLFU/TinyLFU.hpp"
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../common/ThreadStripe.hpp"
+#include "../LRU/LRU.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief 读缓冲 LRU（参考 Caffeine 的读缓冲设计）
+ *
+ * 命中时只持有读锁完成查找，并把访问记录写入按线程分条的环形缓冲区，不立即调整链表；
+ * 缓冲区写满或发生写操作时，在写锁下批量回放这些访问，把节点移动到链表头部。
+ * 缓冲区是有损的：写满后再来的访问会被丢弃，只影响淘汰顺序的精确度，不影响正确性。
+ */
+template <typename KeyType, typename ValueType>
+class BufferedLRUCache : public LRUCache<KeyType, ValueType>
+{
+    using Base    = LRUCache<KeyType, ValueType>;
+    using NodePtr = typename Base::NodePtr;
+
+    static constexpr std::uint32_t kBufferSize = 32; // 每个条带缓冲的访问记录数
+
+    // 单个条带的读缓冲，按缓存行对齐避免伪共享
+    struct alignas(64) ReadBuffer
+    {
+        std::atomic<std::uint32_t> writeCount{0};
+        std::atomic<NodePtr>       slots[kBufferSize]{};
+    };
+
+    std::size_t                   stripeMask_; // 条带数量-1（条带数量为2的幂）
+    std::unique_ptr<ReadBuffer[]> buffers_;    // 各条带的读缓冲
+
+  public:
+    /**
+     * @param capacity 缓存容量
+     * @param stripe_count 读缓冲条带数量，<=0 时按硬件线程数选择，会向上取整为2的幂
+     */
+    BufferedLRUCache(int capacity, int stripe_count = 0);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+
+    // 批量接口同样先回放读缓冲，再在同一次写锁内完成整批访问
+    std::size_t getMany(const KeyType* keys, std::size_t count, ValueType* results,
+                        std::uint64_t* hitBits) override;
+    void        putMany(const KeyType* keys, const ValueType* values, std::size_t count) override;
+
+    // 主缓存的 getOrLoad 不经过读缓冲，写入前也不回放，不提供
+    template <typename Loader>
+    ValueType getOrLoad(const KeyType& key, Loader&& loader) = delete;
+
+  private:
+    /**
+     * @brief 记录一次命中（调用方持有读锁）
+     * @return 当前条带是否已写满，需要回放
+     */
+    bool recordRead(NodePtr node);
+
+    /**
+     * @brief 尝试获取写锁并回放缓冲，获取失败则直接返回
+     */
+    void tryDrain();
+
+    /**
+     * @brief 回放所有条带的访问记录（调用方持有写锁）
+     */
+    void drainBuffers();
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "BufferedLRU.decl.hpp"
+#include "BufferedLRU.impl.hpp"
\ No newline at end of file
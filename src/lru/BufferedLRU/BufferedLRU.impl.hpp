@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../../utils/log.hpp"
+#include "BufferedLRU.decl.hpp"
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+template <typename KeyType, typename ValueType>
+BufferedLRUCache<KeyType, ValueType>::BufferedLRUCache(int capacity, int stripe_count)
+    : LRUCache<KeyType, ValueType>(capacity)
+{
+    std::size_t wanted = stripe_count > 0 ? stripe_count : std::thread::hardware_concurrency();
+    std::size_t stripes = 1;
+    while (stripes < wanted && stripes < 64) stripes <<= 1;
+    stripeMask_ = stripes - 1;
+    buffers_    = std::make_unique<ReadBuffer[]>(stripes);
+}
+
+template <typename KeyType, typename ValueType>
+bool BufferedLRUCache<KeyType, ValueType>::get(const KeyType& key, ValueType& result)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::GetMiss);
+    bool         needDrain = false;
+    std::size_t  hash      = this->hashOf(key);
+    {
+        std::shared_lock<std::shared_mutex> lock(this->mutex_);
+        NodePtr                             node = this->findNode(key, hash);
+        // 读锁下不能移除过期节点，按未命中处理，由写操作推进时间轮回收
+        if (!node || this->expired(node))
+        {
+            this->stats_.miss();
+            this->trace(TraceOp::GetMiss, hash);
+            log("(BufferedLRU get) get failed: ", key, '\n');
+            return false;
+        }
+        this->stats_.hit();
+        this->trace(TraceOp::GetHit, hash);
+        timing.setOp(LatencyOp::GetHit);
+        result    = node->value;
+        needDrain = recordRead(node);
+    }
+
+    if (needDrain)
+        tryDrain();
+
+    log("(BufferedLRU get) get: ", key, " = ", result, '\n');
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType BufferedLRUCache<KeyType, ValueType>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType>
+void BufferedLRUCache<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
+{
+    LatencyScope             timing(this->latency_.get(), LatencyOp::Put);
+    typename Base::WriteLock lock(this->mutex_, this->removals_);
+    // 先回放读缓冲，让淘汰基于最新的访问顺序
+    drainBuffers();
+    this->putLocked(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+void BufferedLRUCache<KeyType, ValueType>::put(KeyType&& key, ValueType&& value)
+{
+    LatencyScope             timing(this->latency_.get(), LatencyOp::Put);
+    typename Base::WriteLock lock(this->mutex_, this->removals_);
+    drainBuffers();
+    this->putLocked(std::move(key), std::move(value));
+}
+
+template <typename KeyType, typename ValueType>
+std::size_t BufferedLRUCache<KeyType, ValueType>::getMany(const KeyType* keys,
+                                                          std::size_t    count,
+                                                          ValueType*     results,
+                                                          std::uint64_t* hitBits)
+{
+    this->clearHitBits(hitBits, count);
+    typename Base::WriteLock lock(this->mutex_, this->removals_);
+    drainBuffers();
+    return this->getManyLocked(keys, nullptr, nullptr, count, results, hitBits);
+}
+
+template <typename KeyType, typename ValueType>
+void BufferedLRUCache<KeyType, ValueType>::putMany(const KeyType* keys, const ValueType* values,
+                                                   std::size_t count)
+{
+    typename Base::WriteLock lock(this->mutex_, this->removals_);
+    drainBuffers();
+    this->putManyLocked(keys, values, nullptr, nullptr, count);
+}
+
+template <typename KeyType, typename ValueType>
+bool BufferedLRUCache<KeyType, ValueType>::recordRead(NodePtr node)
+{
+    ReadBuffer&   buffer = buffers_[threadStripe() & stripeMask_];
+    std::uint32_t index  = buffer.writeCount.fetch_add(1, std::memory_order_relaxed);
+    if (index < kBufferSize)
+        buffer.slots[index].store(node, std::memory_order_relaxed);
+    return index + 1 >= kBufferSize;
+}
+
+template <typename KeyType, typename ValueType>
+void BufferedLRUCache<KeyType, ValueType>::tryDrain()
+{
+    LatencyScope                        timing(this->latency_.get(), LatencyOp::Maintenance);
+    std::unique_lock<std::shared_mutex> lock(this->mutex_, std::try_to_lock);
+    if (lock.owns_lock())
+        drainBuffers();
+    else
+        timing.dismiss();
+}
+
+template <typename KeyType, typename ValueType>
+void BufferedLRUCache<KeyType, ValueType>::drainBuffers()
+{
+    for (std::size_t i = 0; i <= stripeMask_; i++)
+    {
+        ReadBuffer&   buffer = buffers_[i];
+        std::uint32_t count  = std::min(buffer.writeCount.load(std::memory_order_relaxed), kBufferSize);
+        for (std::uint32_t j = 0; j < count; j++)
+        {
+            NodePtr node = buffer.slots[j].exchange(nullptr, std::memory_order_relaxed);
+            // 记录之后节点可能已被淘汰回收（prev 被重置为空），跳过即可；
+            // 若节点已被复用为其他键，提升它只会影响淘汰顺序的精确度
+            if (node && node->prev)
+                this->moveToFirst(node);
+        }
+        buffer.writeCount.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../../common/BaseCache.hpp"
+#include "../../common/FlatMap.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+
+/**
+ * @brief CLOCK 缓存：LRU 的近似实现
+ *
+ * 条目存放在环形数组中，每个槽位有一个原子访问位。命中时只需读锁并置位，
+ * 不移动任何节点；淘汰时时钟指针扫描数组，清除遇到的访问位，淘汰第一个访问位为 0 的槽位。
+ */
+template <typename KeyType, typename ValueType>
+class ClockCache : public BaseCache<KeyType, ValueType>
+{
+    struct Slot
+    {
+        KeyType                   key{};
+        ValueType                 value{};
+        std::size_t               hash{};        // 缓存的哈希值，淘汰时无需重新计算
+        std::atomic<std::uint8_t> referenced{0}; // 访问位
+    };
+
+    // 索引的取键方式：按下标读取环形数组中的键，索引槽位不另存一份
+    struct SlotKey
+    {
+        const Slot* slots{nullptr};
+
+        const KeyType& operator()(std::uint32_t index) const { return slots[index].key; }
+    };
+
+    using SlotIndex =
+        FlatMap<KeyType, std::uint32_t, DefaultHash<KeyType>, std::equal_to<>, SlotKey>;
+
+    int                             capacity_; // 最大容量
+    int                             size_{};   // 当前条目数量
+    std::size_t                     hand_{};   // 时钟指针
+    std::unique_ptr<Slot[]>         slots_;    // 环形数组
+    SlotIndex                       index_;    // key->槽位下标
+    mutable std::shared_mutex       mutex_;    // 命中只需读锁，插入和淘汰需要写锁
+
+  public:
+    ClockCache(int capacity);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    CacheStats stats() const override;
+
+  private:
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value);
+
+    /**
+     * @brief 推进时钟指针，找到可以替换的槽位（调用方持有写锁且缓存已满）
+     */
+    std::uint32_t findVictim();
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "Clock.decl.hpp"
+#include "Clock.impl.hpp"
\ No newline at end of file
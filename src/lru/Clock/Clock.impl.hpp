@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../../utils/log.hpp"
+#include "Clock.decl.hpp"
+#include <algorithm>
+#include <mutex>
+
+template <typename KeyType, typename ValueType>
+ClockCache<KeyType, ValueType>::ClockCache(int capacity)
+    : capacity_(std::max(capacity, 1))
+    , slots_(std::make_unique<Slot[]>(capacity_))
+    , index_(capacity_, SlotKey{slots_.get()})
+{
+}
+
+template <typename KeyType, typename ValueType>
+bool ClockCache<KeyType, ValueType>::get(const KeyType& key, ValueType& result)
+{
+    LatencyScope                        timing(this->latency_.get(), LatencyOp::GetMiss);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const std::uint32_t*                slot = index_.find(key);
+    if (!slot)
+    {
+        this->stats_.miss();
+        log("(Clock get) get failed: ", key, '\n');
+        return false;
+    }
+
+    Slot& entry = slots_[*slot];
+    // 只置访问位；先读再写，避免已置位时反复写同一缓存行
+    if (entry.referenced.load(std::memory_order_relaxed) == 0)
+        entry.referenced.store(1, std::memory_order_relaxed);
+    result = entry.value;
+    this->stats_.hit();
+    timing.setOp(LatencyOp::GetHit);
+    log("(Clock get) get: ", key, " = ", result, '\n');
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType ClockCache<KeyType, ValueType>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType>
+void ClockCache<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+void ClockCache<KeyType, ValueType>::put(KeyType&& key, ValueType&& value)
+{
+    putImpl(std::move(key), std::move(value));
+}
+
+template <typename KeyType, typename ValueType>
+bool ClockCache<KeyType, ValueType>::peek(const KeyType& key, ValueType& result) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (const std::uint32_t* slot = index_.find(key))
+    {
+        result = slots_[*slot].value;
+        return true;
+    }
+    return false;
+}
+
+template <typename KeyType, typename ValueType>
+bool ClockCache<KeyType, ValueType>::contains(const KeyType& key) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.contains(key);
+}
+
+template <typename KeyType, typename ValueType>
+CacheStats ClockCache<KeyType, ValueType>::stats() const
+{
+    CacheStats                          stats = this->stats_.snapshot();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    stats.size   = static_cast<std::size_t>(size_);
+    stats.weight = size_;
+    return stats;
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K, typename V>
+void ClockCache<KeyType, ValueType>::putImpl(K&& key, V&& value)
+{
+    LatencyScope                        timing(this->latency_.get(), LatencyOp::Put);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::size_t                         hash = index_.hashOf(key);
+    this->stats_.put();
+    if (std::uint32_t* slot = index_.find(key, hash))
+    {
+        this->stats_.removal(RemovalCause::Replaced);
+        Slot& entry = slots_[*slot];
+        entry.value = std::forward<V>(value);
+        entry.referenced.store(1, std::memory_order_relaxed);
+        log("(Clock put) update: ", key, '=', entry.value, '\n');
+        return;
+    }
+    log("(Clock put) new put: ", key, '=', value, '\n');
+
+    std::uint32_t target;
+    if (size_ < capacity_)
+    {
+        // 未满时按顺序填充槽位
+        target = static_cast<std::uint32_t>(size_++);
+    }
+    else
+    {
+        LatencyScope evictTiming(this->latency_.get(), LatencyOp::Evict);
+        target       = findVictim();
+        Slot& victim = slots_[target];
+        log("(Clock put) evict: ", victim.key, '\n');
+        this->stats_.removal(RemovalCause::Size);
+        index_.erase(victim.key, victim.hash);
+    }
+
+    Slot& entry = slots_[target];
+    entry.key   = std::forward<K>(key);
+    entry.value = std::forward<V>(value);
+    entry.hash  = hash;
+    // 新条目访问位为 0，未被再次访问前会先于热点条目被淘汰
+    entry.referenced.store(0, std::memory_order_relaxed);
+    index_.insert(hash, target);
+}
+
+template <typename KeyType, typename ValueType>
+std::uint32_t ClockCache<KeyType, ValueType>::findVictim()
+{
+    // 最多扫描两圈：第一圈清除所有访问位，第二圈必定找到访问位为 0 的槽位
+    while (true)
+    {
+        std::uint32_t current = static_cast<std::uint32_t>(hand_);
+        Slot&         entry   = slots_[current];
+        hand_                 = (hand_ + 1) % capacity_;
+        if (entry.referenced.load(std::memory_order_relaxed) == 0)
+            return current;
+        entry.referenced.store(0, std::memory_order_relaxed);
+    }
+}
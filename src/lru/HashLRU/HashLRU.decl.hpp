@@ -1,26 +1,135 @@
 #pragma once
 
 #include "../../common/BaseCache.hpp"
+#include "../../common/CapacityBudget.hpp"
+#include "../../common/Hash.hpp"
+#include "../../common/SliceBatch.hpp"
+#include "../../common/Weigher.hpp"
 #include "../LRU/LRU.hpp"
-#include <cmath>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>>
 class HashLRUCache : public BaseCache<KeyType, ValueType>
 {
-    int                                                        capacity_;     // 总容量
-    int                                                        sliceCount_;   // 分片数量
-    std::vector<std::unique_ptr<LRUCache<KeyType, ValueType>>> slicedCaches_; // 分片缓存
+    // 分片：淘汰节点时把键的哈希记入容量预算的幽灵表
+    class Shard : public LRUCache<KeyType, ValueType, Hasher>
+    {
+        CapacityBudget& budget_;
+
+      public:
+        Shard(int index, std::int64_t capacity, const Weigher<KeyType, ValueType>& weigher,
+              double admissionFraction, CapacityBudget& budget)
+            : LRUCache<KeyType, ValueType, Hasher>(capacity, weigher, admissionFraction)
+            , budget_(budget)
+        {
+            this->traceShard_ = static_cast<std::uint16_t>(index);
+        }
+
+        // 刷新任务会调用被重写的 removeLast，要在本类析构之前停下
+        ~Shard() override { this->stopRefresh(); }
+
+        using LRUCache<KeyType, ValueType, Hasher>::containsImpl;
+        using LRUCache<KeyType, ValueType, Hasher>::getImpl;
+        using LRUCache<KeyType, ValueType, Hasher>::getManyAt;
+        using LRUCache<KeyType, ValueType, Hasher>::load;
+        using LRUCache<KeyType, ValueType, Hasher>::peekImpl;
+        using LRUCache<KeyType, ValueType, Hasher>::putImpl;
+        using LRUCache<KeyType, ValueType, Hasher>::putManyAt;
+        using LRUCache<KeyType, ValueType, Hasher>::refresh;
+
+      protected:
+        void removeLast() override;
+    };
+
+    CapacityBudget                      budget_;       // 容量预算，负责均分和再平衡
+    int                                 sliceCount_;   // 分片数量
+    std::vector<std::unique_ptr<Shard>> slicedCaches_; // 分片缓存
 
   public:
-    HashLRUCache(int capacity, int slice_count);
+    /**
+     * @param capacity 总容量，各分片容量之和恒等于总容量
+     * @param slice_count 分片数量，<=0 时使用硬件线程数
+     * @param adaptive 是否按各分片的未命中压力在分片间移动容量
+     */
+    HashLRUCache(int capacity, int slice_count, bool adaptive = false);
+
+    /**
+     * @brief 按权重计容量的分片 LRU 缓存
+     * @param capacity 总权重上限（如字节数），按分片均分
+     * @param slice_count 分片数量，<=0 时使用硬件线程数
+     * @param weigher 条目权重函数
+     * @param admissionFraction 权重超过 分片容量 * admissionFraction 的条目拒绝写入
+     * @param adaptive 是否按各分片的未命中压力在分片间移动容量
+     */
+    HashLRUCache(std::int64_t capacity, int slice_count, Weigher<KeyType, ValueType> weigher,
+                 double admissionFraction = 1.0, bool adaptive = false);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    // 带过期时间的写入，ttl <= 0 表示永不过期
+    void put(const KeyType& key, const ValueType& value, std::chrono::milliseconds ttl);
+    void put(KeyType&& key, ValueType&& value, std::chrono::milliseconds ttl);
+
+    // 设置所有分片不指定 ttl 写入时使用的过期时间
+    void setDefaultTtl(std::chrono::milliseconds ttl);
 
-    bool      get(KeyType key, ValueType& result) override;
-    ValueType get(KeyType key) override;
-    void      put(KeyType key, ValueType value) override;
+    // 设置所有分片的写后刷新间隔，interval <= 0 关闭刷新
+    void setRefreshAfterWrite(std::chrono::milliseconds interval);
+
+    // 为所有分片设置移除监听器，每个分片各自缓冲事件，在释放分片锁之后投递
+    void setRemovalListener(RemovalListener<KeyType, ValueType> listener,
+                            ThreadPool*                         executor = nullptr);
+
+    // 统计由各分片分别计数，读取时相加
+    void       setStatsEnabled(bool enabled) override;
+    CacheStats stats() const override;
+
+    // 各分片与本类共用同一个延迟记录器
+    void setLatencyRecorder(std::shared_ptr<LatencyRecorder> recorder) override;
+
+    /**
+     * @brief 查询，未命中时调用 loader(key) 加载并写入缓存
+     *
+     * 同一个键的并发未命中在所在分片内合并为一次加载，其余线程等待并共享结果。
+     */
+    template <typename Loader>
+    ValueType getOrLoad(const KeyType& key, Loader&& loader);
+
+    // 异构查找：如 std::string 键可直接用 std::string_view 查询
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool get(const K& key, ValueType& result);
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool peek(const K& key, ValueType& result) const;
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool contains(const K& key) const;
+
+    /**
+     * @brief 批量接口：按分片分组，每个分片只加一次锁处理属于它的键
+     */
+    std::size_t getMany(const KeyType* keys, std::size_t count, ValueType* results,
+                        std::uint64_t* hitBits) override;
+    void        putMany(const KeyType* keys, const ValueType* values, std::size_t count) override;
 
   private:
-    int getHash(KeyType key);
+    // hash 为 getHash(key)，选分片和分片内查找共用；stale 见分片的 getImpl
+    template <typename K>
+    bool getImpl(const K& key, std::size_t hash, ValueType& result, bool* stale = nullptr);
+
+    // 按分片压力移动容量，调用时不能持有分片锁
+    void rebalance();
+
+    template <typename K>
+    std::size_t getHash(const K& key) const;
+    int         getSliceIndex(std::size_t hash) const;
 };
@@ -1,43 +1,267 @@
 #pragma once
 
 #include "HashLRU.decl.hpp"
-#include <functional>
 
-template <typename KeyType, typename ValueType>
-HashLRUCache<KeyType, ValueType>::HashLRUCache(int capacity, int slice_count)
-    : capacity_(capacity)
-    , sliceCount_(slice_count > 0 ? slice_count : std::thread::hardware_concurrency())
+template <typename KeyType, typename ValueType, typename Hasher>
+HashLRUCache<KeyType, ValueType, Hasher>::HashLRUCache(int capacity, int slice_count, bool adaptive)
+    : HashLRUCache(capacity, slice_count, Weigher<KeyType, ValueType>{}, 1.0, adaptive)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+HashLRUCache<KeyType, ValueType, Hasher>::HashLRUCache(std::int64_t capacity, int slice_count,
+                                                       Weigher<KeyType, ValueType> weigher,
+                                                       double admissionFraction, bool adaptive)
+    : budget_(capacity,
+              slice_count > 0 ? slice_count : static_cast<int>(std::thread::hardware_concurrency()),
+              adaptive)
+    , sliceCount_(budget_.shardCount())
 {
-    int slice_size = std::ceil(static_cast<double>(capacity_) / sliceCount_);
     slicedCaches_.reserve(sliceCount_);
     for (int i = 0; i < sliceCount_; i++)
-        slicedCaches_.emplace_back(std::make_unique<LRUCache<KeyType, ValueType>>(slice_size));
+        slicedCaches_.emplace_back(std::make_unique<Shard>(
+            i, budget_.initialShare(i), weigher, admissionFraction, budget_));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool HashLRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key, ValueType& result)
+{
+    return getImpl(key, getHash(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool HashLRUCache<KeyType, ValueType, Hasher>::get(const K& key, ValueType& result)
+{
+    return getImpl(key, getHash(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+ValueType HashLRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key)
+{
+    ValueType result{};
+    getImpl(key, getHash(key), result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value)
+{
+    std::size_t hash = getHash(key);
+    slicedCaches_[getSliceIndex(hash)]->putImpl(key, value, hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value)
+{
+    std::size_t hash = getHash(key);
+    slicedCaches_[getSliceIndex(hash)]->putImpl(std::move(key), std::move(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value,
+                                                   std::chrono::milliseconds ttl)
+{
+    std::size_t hash = getHash(key);
+    slicedCaches_[getSliceIndex(hash)]->putImpl(key, value, hash, ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value,
+                                                   std::chrono::milliseconds ttl)
+{
+    std::size_t hash = getHash(key);
+    slicedCaches_[getSliceIndex(hash)]->putImpl(std::move(key), std::move(value), hash, ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::setDefaultTtl(std::chrono::milliseconds ttl)
+{
+    for (auto& slice : slicedCaches_) slice->setDefaultTtl(ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::setRefreshAfterWrite(
+    std::chrono::milliseconds interval)
+{
+    for (auto& slice : slicedCaches_) slice->setRefreshAfterWrite(interval);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::setRemovalListener(
+    RemovalListener<KeyType, ValueType> listener, ThreadPool* executor)
+{
+    for (auto& slice : slicedCaches_) slice->setRemovalListener(listener, executor);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::setStatsEnabled(bool enabled)
+{
+    for (auto& slice : slicedCaches_) slice->setStatsEnabled(enabled);
 }
 
-template <typename KeyType, typename ValueType>
-bool HashLRUCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
+template <typename KeyType, typename ValueType, typename Hasher>
+CacheStats HashLRUCache<KeyType, ValueType, Hasher>::stats() const
 {
-    int slice_index = getHash(key) % sliceCount_;
-    return slicedCaches_[slice_index]->get(key, result);
+    CacheStats stats;
+    for (const auto& slice : slicedCaches_) stats += slice->stats();
+    return stats;
 }
 
-template <typename KeyType, typename ValueType>
-ValueType HashLRUCache<KeyType, ValueType>::get(KeyType key)
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::setLatencyRecorder(
+    std::shared_ptr<LatencyRecorder> recorder)
 {
-    int slice_index = getHash(key) % sliceCount_;
-    return slicedCaches_[slice_index]->get(key);
+    for (auto& slice : slicedCaches_) slice->setLatencyRecorder(recorder);
+    this->latency_ = std::move(recorder);
 }
 
-template <typename KeyType, typename ValueType>
-void HashLRUCache<KeyType, ValueType>::put(KeyType key, ValueType value)
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+ValueType HashLRUCache<KeyType, ValueType, Hasher>::getOrLoad(const KeyType& key, Loader&& loader)
 {
-    int slice_index = getHash(key) % sliceCount_;
-    slicedCaches_[slice_index]->put(key, value);
+    // 先走普通查询，未命中照常计入分片压力
+    ValueType   result{};
+    bool        stale = false;
+    std::size_t hash  = getHash(key);
+    if (!getImpl(key, hash, result, &stale))
+        return slicedCaches_[getSliceIndex(hash)]->load(key, hash, std::forward<Loader>(loader));
+    if (stale)
+        slicedCaches_[getSliceIndex(hash)]->refresh(key, hash, std::forward<Loader>(loader));
+    return result;
 }
 
-template <typename KeyType, typename ValueType>
-int HashLRUCache<KeyType, ValueType>::getHash(KeyType key)
+template <typename KeyType, typename ValueType, typename Hasher>
+bool HashLRUCache<KeyType, ValueType, Hasher>::peek(const KeyType& key, ValueType& result) const
 {
-    std::hash<KeyType> hash_func;
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->peekImpl(key, hash, result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool HashLRUCache<KeyType, ValueType, Hasher>::peek(const K& key, ValueType& result) const
+{
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->peekImpl(key, hash, result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool HashLRUCache<KeyType, ValueType, Hasher>::contains(const KeyType& key) const
+{
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->containsImpl(key, hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool HashLRUCache<KeyType, ValueType, Hasher>::contains(const K& key) const
+{
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->containsImpl(key, hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t HashLRUCache<KeyType, ValueType, Hasher>::getMany(const KeyType* keys,
+                                                              std::size_t    count,
+                                                              ValueType*     results,
+                                                              std::uint64_t* hitBits)
+{
+    this->clearHitBits(hitBits, count);
+    if (count == 0)
+        return 0;
+
+    // 自适应模式需要逐个键判断是否命中，调用方不关心命中位图时使用临时位图
+    std::vector<std::uint64_t> localBits;
+    if (!hitBits && budget_.adaptive())
+    {
+        localBits.assign((count + 63) / 64, 0);
+        hitBits = localBits.data();
+    }
+
+    SliceBatch         batch(keys, count, static_cast<std::size_t>(sliceCount_), Hasher{});
+    const std::size_t* hashes       = batch.hashes();
+    std::size_t        hits         = 0;
+    bool               rebalanceDue = false;
+    for (int s = 0; s < sliceCount_; s++)
+    {
+        const std::uint32_t* positions = batch.positions(s);
+        std::size_t          size      = batch.size(s);
+        if (size == 0)
+            continue;
+        hits += slicedCaches_[s]->getManyAt(keys, hashes, positions, size, results, hitBits);
+
+        if (!budget_.adaptive())
+            continue;
+        for (std::size_t n = 0; n < size; n++)
+        {
+            std::uint32_t i = positions[n];
+            if (!((hitBits[i / 64] >> (i % 64)) & 1) && budget_.recordMiss(s, hashes[i]))
+                rebalanceDue = true;
+        }
+    }
+
+    // 再平衡会锁住分片，放在所有分片处理完之后
+    if (rebalanceDue)
+        rebalance();
+    return hits;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::putMany(const KeyType*   keys,
+                                                       const ValueType* values,
+                                                       std::size_t      count)
+{
+    SliceBatch batch(keys, count, static_cast<std::size_t>(sliceCount_), Hasher{});
+    for (int s = 0; s < sliceCount_; s++)
+    {
+        if (std::size_t size = batch.size(s))
+            slicedCaches_[s]->putManyAt(keys, values, batch.hashes(), batch.positions(s), size);
+    }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool HashLRUCache<KeyType, ValueType, Hasher>::getImpl(const K& key, std::size_t hash,
+                                                       ValueType& result, bool* stale)
+{
+    int slice_index = getSliceIndex(hash);
+    if (slicedCaches_[slice_index]->getImpl(key, hash, result, stale))
+        return true;
+
+    // 未命中计入分片压力；再平衡会锁住分片，必须在分片的 get 返回之后进行
+    if (budget_.recordMiss(slice_index, hash))
+        rebalance();
+    return false;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::rebalance()
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Maintenance);
+    budget_.rebalance([this](int index, std::int64_t delta)
+                      { slicedCaches_[index]->changeCapacity(delta); });
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+std::size_t HashLRUCache<KeyType, ValueType, Hasher>::getHash(const K& key) const
+{
+    // 与分片内索引使用同一哈希函数，保证异构键落在同一分片
+    Hasher hash_func;
     return hash_func(key);
 }
+
+template <typename KeyType, typename ValueType, typename Hasher>
+int HashLRUCache<KeyType, ValueType, Hasher>::getSliceIndex(std::size_t hash) const
+{
+    return static_cast<int>(sliceOf(hash, static_cast<std::size_t>(sliceCount_)));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashLRUCache<KeyType, ValueType, Hasher>::Shard::removeLast()
+{
+    if (auto node = this->getLastNode())
+        budget_.recordEviction(node->hash);
+    LRUCache<KeyType, ValueType, Hasher>::removeLast();
+}
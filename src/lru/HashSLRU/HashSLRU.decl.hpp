@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../common/BaseCache.hpp"
+#include "../../common/Hash.hpp"
+#include "../SLRU/SLRU.hpp"
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>>
+class HashSLRUCache : public BaseCache<KeyType, ValueType>
+{
+    // 分片：公开按预先算好的哈希访问的接口
+    class Shard : public SLRUCache<KeyType, ValueType, Hasher>
+    {
+      public:
+        using SLRUCache<KeyType, ValueType, Hasher>::SLRUCache;
+
+        using SLRUCache<KeyType, ValueType, Hasher>::containsImpl;
+        using SLRUCache<KeyType, ValueType, Hasher>::getImpl;
+        using SLRUCache<KeyType, ValueType, Hasher>::peekImpl;
+        using SLRUCache<KeyType, ValueType, Hasher>::putImpl;
+    };
+
+    int                                 capacity_;     // 总容量
+    int                                 sliceCount_;   // 分片数量
+    std::vector<std::unique_ptr<Shard>> slicedCaches_; // 分片缓存
+
+  public:
+    /**
+     * @param capacity 总容量，按分片数量均分，余数分给前几个分片
+     * @param slice_count 分片数量，<=0 时使用硬件线程数
+     */
+    HashSLRUCache(int capacity, int slice_count);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    // 统计由各分片分别计数，读取时相加
+    void       setStatsEnabled(bool enabled) override;
+    CacheStats stats() const override;
+
+    // 各分片与本类共用同一个延迟记录器
+    void setLatencyRecorder(std::shared_ptr<LatencyRecorder> recorder) override;
+
+  private:
+    std::size_t getHash(const KeyType& key) const;
+    std::size_t getSliceIndex(std::size_t hash) const;
+};
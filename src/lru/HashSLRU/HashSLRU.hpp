@@ -0,0 +1,4 @@
+#pragma once
+
+#include "HashSLRU.decl.hpp"
+#include "HashSLRU.impl.hpp"
\ No newline at end of file
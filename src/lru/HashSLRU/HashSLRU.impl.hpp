@@ -0,0 +1,97 @@
+#pragma once
+
+#include "HashSLRU.decl.hpp"
+#include <algorithm>
+
+template <typename KeyType, typename ValueType, typename Hasher>
+HashSLRUCache<KeyType, ValueType, Hasher>::HashSLRUCache(int capacity, int slice_count)
+    : capacity_(capacity)
+    , sliceCount_(slice_count > 0 ? slice_count : std::thread::hardware_concurrency())
+{
+    // hardware_concurrency 可能返回 0；分片数量不超过容量，保证每个分片至少有一个位置
+    sliceCount_ = std::clamp(sliceCount_, 1, std::max(capacity_, 1));
+    slicedCaches_.reserve(sliceCount_);
+    for (int i = 0; i < sliceCount_; i++)
+    {
+        int slice_size = capacity_ / sliceCount_ + (i < capacity_ % sliceCount_ ? 1 : 0);
+        slicedCaches_.emplace_back(std::make_unique<Shard>(slice_size));
+    }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool HashSLRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key, ValueType& result)
+{
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->getImpl(key, hash, result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+ValueType HashSLRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashSLRUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value)
+{
+    std::size_t hash = getHash(key);
+    slicedCaches_[getSliceIndex(hash)]->putImpl(key, value, hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashSLRUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value)
+{
+    std::size_t hash = getHash(key);
+    slicedCaches_[getSliceIndex(hash)]->putImpl(std::move(key), std::move(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool HashSLRUCache<KeyType, ValueType, Hasher>::peek(const KeyType& key, ValueType& result) const
+{
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->peekImpl(key, hash, result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool HashSLRUCache<KeyType, ValueType, Hasher>::contains(const KeyType& key) const
+{
+    std::size_t hash = getHash(key);
+    return slicedCaches_[getSliceIndex(hash)]->containsImpl(key, hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashSLRUCache<KeyType, ValueType, Hasher>::setStatsEnabled(bool enabled)
+{
+    for (auto& slice : slicedCaches_) slice->setStatsEnabled(enabled);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+CacheStats HashSLRUCache<KeyType, ValueType, Hasher>::stats() const
+{
+    CacheStats stats;
+    for (const auto& slice : slicedCaches_) stats += slice->stats();
+    return stats;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void HashSLRUCache<KeyType, ValueType, Hasher>::setLatencyRecorder(
+    std::shared_ptr<LatencyRecorder> recorder)
+{
+    for (auto& slice : slicedCaches_) slice->setLatencyRecorder(recorder);
+    this->latency_ = std::move(recorder);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t HashSLRUCache<KeyType, ValueType, Hasher>::getHash(const KeyType& key) const
+{
+    // 与分片内索引使用同一哈希函数，算一次供选分片和分片内查找共用
+    return Hasher{}(key);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t HashSLRUCache<KeyType, ValueType, Hasher>::getSliceIndex(std::size_t hash) const
+{
+    return sliceOf(hash, static_cast<std::size_t>(sliceCount_));
+}
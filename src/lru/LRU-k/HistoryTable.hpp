@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief LRU-K 的指纹访问历史表
+ *
+ * 固定大小的组相联表：每组 kWays 个条目，每个条目 4 字节，高 24 位是键哈希的指纹，低 8 位是访问次数。
+ * 不保存键和值，不同的键可能因指纹冲突而共享计数；组内按最近访问排序，组满时淘汰最久未访问的条目。
+ * 访问次数在 kMaxCount 处饱和。
+ */
+class HistoryTable
+{
+    static constexpr std::size_t   kWays      = 8;    // 每组条目数，一组占 32 字节
+    static constexpr std::uint32_t kCountMask = 0xFF; // 访问次数所在的低 8 位
+
+    std::vector<std::uint32_t> entries_; // 所有组的条目，0 表示空条目
+    std::size_t                setMask_; // 组数量-1（组数量为2的幂）
+
+  public:
+    static constexpr int kMaxCount = static_cast<int>(kCountMask); // increment 能返回的最大次数
+
+    /**
+     * @param capacity 期望记录的键数量
+     */
+    explicit HistoryTable(std::size_t capacity);
+
+    /**
+     * @brief 访问次数加一，不存在时新建记录
+     * @return 加一后的访问次数，不超过 kMaxCount
+     */
+    int increment(std::size_t hash);
+
+    /**
+     * @brief 删除记录
+     */
+    void erase(std::size_t hash);
+
+    void clear() { std::fill(entries_.begin(), entries_.end(), 0); }
+
+    std::size_t bytesReserved() const { return entries_.size() * sizeof(std::uint32_t); }
+
+  private:
+    static std::uint64_t mix(std::uint64_t hash)
+    {
+        // MurmurHash3 fmix64
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    // 指纹取混合后哈希的高 24 位，保证非零以区分空条目
+    static std::uint32_t fingerprint(std::uint64_t mixed)
+    {
+        return (static_cast<std::uint32_t>(mixed >> 40) | 1) << 8;
+    }
+
+    std::uint32_t* setOf(std::uint64_t mixed) { return &entries_[(mixed & setMask_) * kWays]; }
+};
+
+inline HistoryTable::HistoryTable(std::size_t capacity)
+{
+    std::size_t sets = 1;
+    while (sets * kWays < capacity) sets *= 2;
+    setMask_ = sets - 1;
+    entries_.assign(sets * kWays, 0);
+}
+
+inline int HistoryTable::increment(std::size_t hash)
+{
+    std::uint64_t  mixed = mix(hash);
+    std::uint32_t  fp    = fingerprint(mixed);
+    std::uint32_t* set   = setOf(mixed);
+
+    // 找到已有记录则取出，否则淘汰组内最后一个条目
+    std::size_t way = 0;
+    while (way < kWays - 1 && set[way] != 0 && (set[way] & ~kCountMask) != fp) way++;
+    std::uint32_t count = (set[way] & ~kCountMask) == fp ? set[way] & kCountMask : 0;
+    count               = std::min<std::uint32_t>(count + 1, kCountMask);
+
+    // 其余条目后移一位，当前条目放到组首（最近访问）
+    std::copy_backward(set, set + way, set + way + 1);
+    set[0] = fp | count;
+    return static_cast<int>(count);
+}
+
+inline void HistoryTable::erase(std::size_t hash)
+{
+    std::uint64_t  mixed = mix(hash);
+    std::uint32_t  fp    = fingerprint(mixed);
+    std::uint32_t* set   = setOf(mixed);
+
+    for (std::size_t way = 0; way < kWays && set[way] != 0; way++)
+    {
+        if ((set[way] & ~kCountMask) == fp)
+        {
+            // 后续条目前移，空条目留在组尾
+            std::copy(set + way + 1, set + kWays, set + way);
+            set[kWays - 1] = 0;
+            return;
+        }
+    }
+}
@@ -1,24 +1,59 @@
 #pragma once
 
+#include "../../common/FlatMap.hpp"
 #include "../LRU/LRU.hpp"
+#include "HistoryTable.hpp"
 #include <memory>
 #include <mutex>
 
+// LRU-K 访问历史的记录方式
+enum class LRUKHistory
+{
+    Exact,       // 完整记录键和未晋升的值，get 达到 k 次即可晋升
+    Fingerprint, // 只记录键哈希的指纹和访问次数，不保存值，只有 put 能晋升；k 不超过 255
+};
+
 template <typename KeyType, typename ValueType>
 class LRUKCache : public LRUCache<KeyType, ValueType>
 {
-    using MapType = std::unordered_map<KeyType, ValueType>;
+    using MapType = FlatMap<KeyType, ValueType>;
 
-    int                                     k_;          // 访问多少次进入缓存
-    MapType                                 historyMap_; // 存储访问次数未达到k次的数据
+    int                                     k_;             // 访问多少次进入缓存
+    LRUKHistory                             mode_;          // 访问历史的记录方式
+    MapType                                 historyMap_;    // 存储访问次数未达到k次的数据
     std::unique_ptr<LRUCache<KeyType, int>> history_cache_; // 访问数据历史记录
+    std::unique_ptr<HistoryTable>           fingerprints_;  // 指纹模式下的访问历史
 
-    mutable std::mutex history_mutex_; // 保护historyMap_和history_cache_的互斥锁
+    mutable std::mutex history_mutex_; // 保护访问历史的互斥锁
 
   public:
-    LRUKCache(int k, int capacity, int history_capacity);
+    /**
+     * @param k 访问多少次进入缓存；指纹模式的计数在 HistoryTable::kMaxCount (255) 处饱和，
+     *          更大的 k 会被截断为该值，否则键永远无法晋升
+     * @param capacity 主缓存容量
+     * @param history_capacity 访问历史记录的键数量
+     * @param mode 访问历史的记录方式，指纹模式下每个键只占 4 字节，未晋升的 put 不保留值
+     *
+     * 统计中的 hits/misses 只针对主缓存：get 触发晋升时记为一次未命中和一次晋升；
+     * 未晋升的 put 只更新访问历史，不计入 puts。
+     */
+    LRUKCache(int k, int capacity, int history_capacity, LRUKHistory mode = LRUKHistory::Exact);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+
+    // 批量接口逐个键经过访问历史，主缓存整批加锁的实现会跳过 K 次晋升
+    std::size_t getMany(const KeyType* keys, std::size_t count, ValueType* results,
+                        std::uint64_t* hitBits) override;
+    void        putMany(const KeyType* keys, const ValueType* values, std::size_t count) override;
+
+    // 主缓存的 getOrLoad 把加载的值直接写入主缓存，绕过访问历史，不提供
+    template <typename Loader>
+    ValueType getOrLoad(const KeyType& key, Loader&& loader) = delete;
 
-    bool      get(KeyType key, ValueType& result) override;
-    ValueType get(KeyType key) override;
-    void      put(KeyType key, ValueType value) override;
+  private:
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value);
 };
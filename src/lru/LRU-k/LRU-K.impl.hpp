@@ -2,17 +2,23 @@
 
 #include "../../utils/log.hpp"
 #include "LRU-K.decl.hpp"
+#include <algorithm>
 
 template <typename KeyType, typename ValueType>
-LRUKCache<KeyType, ValueType>::LRUKCache(int k, int capacity, int history_capacity)
+LRUKCache<KeyType, ValueType>::LRUKCache(int k, int capacity, int history_capacity,
+                                         LRUKHistory mode)
     : LRUCache<KeyType, ValueType>(capacity)
-    , k_(k)
-    , history_cache_(std::make_unique<LRUCache<KeyType, int>>(history_capacity))
+    , k_(mode == LRUKHistory::Fingerprint ? std::min(k, HistoryTable::kMaxCount) : k)
+    , mode_(mode)
 {
+    if (mode_ == LRUKHistory::Fingerprint)
+        fingerprints_ = std::make_unique<HistoryTable>(std::max(history_capacity, 1));
+    else
+        history_cache_ = std::make_unique<LRUCache<KeyType, int>>(history_capacity);
 }
 
 template <typename KeyType, typename ValueType>
-bool LRUKCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
+bool LRUKCache<KeyType, ValueType>::get(const KeyType& key, ValueType& result)
 {
     ValueType temp_value;
     bool      should_promote = false;
@@ -24,7 +30,13 @@ bool LRUKCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
 
         // 尝试从主缓存中获取数据
         inMainCache = LRUCache<KeyType, ValueType>::get(key, result);
-        if (!inMainCache)
+        if (!inMainCache && fingerprints_)
+        {
+            // 指纹模式不保存值，只累计访问次数，等待 put 晋升
+            int historyCount = fingerprints_->increment(this->hashOf(key));
+            log("[LRU-K get] update access count: ", key, " count=", historyCount, '\n');
+        }
+        else if (!inMainCache)
         {
             // 获取并更新访问历史计数
             int historyCount = history_cache_->get(key); // 若无则返回默认值
@@ -36,14 +48,15 @@ bool LRUKCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
             if (historyCount >= k_)
             {
                 log("[LRU-K get] count reached k\n");
-                auto it = historyMap_.find(key);
-                if (it != historyMap_.end())
+                std::size_t hash = historyMap_.hashOf(key);
+                if (ValueType* history = historyMap_.find(key, hash))
                 {
-                    temp_value = it->second;
+                    temp_value = std::move(*history);
                     // 删除历史记录
-                    historyMap_.erase(it);
+                    historyMap_.erase(key, hash);
                     history_cache_->removeByKey(key);
                     should_promote = true;
+                    this->stats_.promotion();
                 }
             }
         }
@@ -69,7 +82,7 @@ bool LRUKCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
 }
 
 template <typename KeyType, typename ValueType>
-ValueType LRUKCache<KeyType, ValueType>::get(KeyType key)
+ValueType LRUKCache<KeyType, ValueType>::get(const KeyType& key)
 {
     ValueType result{};
     get(key, result);
@@ -77,7 +90,34 @@ ValueType LRUKCache<KeyType, ValueType>::get(KeyType key)
 }
 
 template <typename KeyType, typename ValueType>
-void LRUKCache<KeyType, ValueType>::put(KeyType key, ValueType value)
+void LRUKCache<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+void LRUKCache<KeyType, ValueType>::put(KeyType&& key, ValueType&& value)
+{
+    putImpl(std::move(key), std::move(value));
+}
+
+template <typename KeyType, typename ValueType>
+std::size_t LRUKCache<KeyType, ValueType>::getMany(const KeyType* keys, std::size_t count,
+                                                   ValueType* results, std::uint64_t* hitBits)
+{
+    return BaseCache<KeyType, ValueType>::getMany(keys, count, results, hitBits);
+}
+
+template <typename KeyType, typename ValueType>
+void LRUKCache<KeyType, ValueType>::putMany(const KeyType* keys, const ValueType* values,
+                                            std::size_t count)
+{
+    BaseCache<KeyType, ValueType>::putMany(keys, values, count);
+}
+
+template <typename KeyType, typename ValueType>
+template <typename K, typename V>
+void LRUKCache<KeyType, ValueType>::putImpl(K&& key, V&& value)
 {
     bool should_promote = false;
     bool inMainCache    = false;
@@ -86,19 +126,28 @@ void LRUKCache<KeyType, ValueType>::put(KeyType key, ValueType value)
     {
         std::lock_guard<std::mutex> history_lock(history_mutex_);
 
-        ValueType existing_value;
-        inMainCache = LRUCache<KeyType, ValueType>::get(key, existing_value);
-        // 已在主缓存中，标记需要更新
-        if (!inMainCache)
+        // 只探测主缓存，不改变其访问顺序
+        inMainCache = this->contains(key);
+        if (!inMainCache && fingerprints_)
+        {
+            std::size_t hash          = this->hashOf(key);
+            int         history_count = fingerprints_->increment(hash);
+            log("[LRU-K put] update access count: ", key, " count=", history_count, '\n');
+
+            // 达到 k 次才晋升，否则丢弃值，只保留计数
+            if (history_count >= k_)
+            {
+                fingerprints_->erase(hash);
+                should_promote = true;
+                this->stats_.promotion();
+            }
+        }
+        else if (!inMainCache)
         {
             // 不在主缓存，更新访问历史
             int history_count = history_cache_->get(key);
             history_count++;
             log("[LRU-K put] update access count: ", key, " count=", history_count, '\n');
-            history_cache_->put(key, history_count);
-
-            // 保存值到历史记录映射，供后续 get 操作使用
-            historyMap_[key] = value;
 
             // 检查是否达到 k 次
             if (history_count >= k_)
@@ -107,6 +156,13 @@ void LRUKCache<KeyType, ValueType>::put(KeyType key, ValueType value)
                 history_cache_->removeByKey(key);
                 historyMap_.erase(key);
                 should_promote = true;
+                this->stats_.promotion();
+            }
+            else
+            {
+                history_cache_->put(key, history_count);
+                // 保存值到历史记录映射，供后续 get 操作使用
+                historyMap_[key] = std::forward<V>(value);
             }
         }
     } // history_lock自动释放
@@ -114,13 +170,13 @@ void LRUKCache<KeyType, ValueType>::put(KeyType key, ValueType value)
     // 在锁外进行主缓存操作
     if (inMainCache)
     {
-        LRUCache<KeyType, ValueType>::put(key, value);
         log("[LRU-K put get] update main cache: ", key, '=', value, '\n');
+        LRUCache<KeyType, ValueType>::put(std::forward<K>(key), std::forward<V>(value));
     }
     else if (should_promote)
     {
         // 达到 k 次，将数据放入主缓存
-        LRUCache<KeyType, ValueType>::put(key, value);
         log("[LRU-K put] add to main cache: ", key, '=', value, '\n');
+        LRUCache<KeyType, ValueType>::put(std::forward<K>(key), std::forward<V>(value));
     }
 }
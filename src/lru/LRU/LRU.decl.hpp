@@ -1,47 +1,229 @@
 #pragma once
 
 #include "../../common/BaseCache.hpp"
+#include "../../common/CoarseClock.hpp"
+#include "../../common/FlatMap.hpp"
+#include "../../common/Hash.hpp"
 #include "../../common/Node.hpp"
-#include <memory>
+#include "../../common/NodeMeta.hpp"
+#include "../../common/NodePool.hpp"
+#include "../../common/Prefetch.hpp"
+#include "../../common/RemovalListener.hpp"
+#include "../../common/SingleFlight.hpp"
+#include "../../common/ThreadPool.hpp"
+#include "../../common/Weigher.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <shared_mutex>
-#include <unordered_map>
+#include <type_traits>
 
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>>
 class LRUCache : public BaseCache<KeyType, ValueType>
 {
+  protected:
     using NodeType = Node<KeyType, ValueType>;
-    using NodePtr  = std::shared_ptr<NodeType>;
-    using NodeMap  = std::unordered_map<KeyType, NodePtr>;
+    using NodePtr  = NodeType*;
+
+  private:
+    using NodeMap = FlatMap<KeyType, NodePtr, Hasher, std::equal_to<>, NodeKey>;
+
+    static constexpr std::size_t kPrefetchGroup = 16; // 批量查询时一组同时预取的键数量
+    static constexpr std::size_t kExpireBatch   = 64; // 每次推进时间轮最多清理的过期节点数
 
-    int     capacity_;    // 最大容量
-    int     nodeCount_{}; // 当前节点数量
-    NodePtr first_;       // 虚拟头节点
-    NodePtr last_;        // 虚拟尾节点
-    NodeMap map_;         // 哈希表
+    WeightBudget<KeyType, ValueType> weights_;      // 容量与当前总权重，默认每个条目权重为 1
+    int                              nodeCount_{};  // 当前节点数量
+    NodeType                         first_;        // 虚拟头节点
+    NodeType                         last_;         // 虚拟尾节点
+    NodeMap                          map_;          // 哈希表
+    NodePool<NodeType>               pool_;         // 节点池，淘汰的节点回收复用
+    NodeMetaTable<NodeType>          meta_;         // 过期时间、权重和刷新状态，只为用到的节点保存
+    std::int64_t                     defaultTtl_{}; // 未指定 ttl 时的过期时间（毫秒），0 为永不过期
+
+    SingleFlight<KeyType, ValueType, Hasher> loads_;          // 合并同一个键的并发加载
+    std::int64_t                             refreshAfter_{}; // 写后刷新间隔（毫秒），0 为不刷新
+    TaskGroup                                refreshes_;      // 提交到共享线程池的后台刷新
+
+  protected:
+    // 会移除条目的操作都用它加写锁，释放锁之后投递本次的移除事件
+    using WriteLock = RemovalGuard<RemovalNotifier<KeyType, ValueType>, std::shared_mutex>;
 
-    mutable std::shared_mutex mutex_; // 读写锁，支持多个读线程并发访问
+    mutable std::shared_mutex           mutex_;    // 读写锁，支持多个读线程并发访问
+    RemovalNotifier<KeyType, ValueType> removals_; // 移除事件，由 mutex_ 保护，释放锁后投递
 
   public:
     LRUCache(int capacity);
 
-    bool      get(KeyType key, ValueType& result) override;
-    ValueType get(KeyType key) override;
-    void      put(KeyType key, ValueType value) override;
+    /**
+     * @brief 按权重计容量的 LRU 缓存
+     * @param capacity 总权重上限（如字节数）
+     * @param weigher 条目权重函数
+     * @param admissionFraction 权重超过 capacity * admissionFraction 的条目拒绝写入
+     */
+    LRUCache(std::int64_t capacity, Weigher<KeyType, ValueType> weigher,
+             double admissionFraction = 1.0);
+
+    // 等待正在执行的后台刷新结束，尚未开始的刷新直接放弃
+    ~LRUCache() override;
+
+    LRUCache(const LRUCache&)            = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    /**
+     * @brief 带过期时间的写入，ttl <= 0 表示永不过期
+     *
+     * 过期的条目对 get/peek/contains 立即不可见，占用的位置由时间轮随后续访问分批回收。
+     */
+    void put(const KeyType& key, const ValueType& value, std::chrono::milliseconds ttl);
+    void put(KeyType&& key, ValueType&& value, std::chrono::milliseconds ttl);
+
+    // 设置不指定 ttl 写入时使用的过期时间，只影响之后写入的条目
+    void setDefaultTtl(std::chrono::milliseconds ttl);
+
+    /**
+     * @brief 设置写后刷新间隔，interval <= 0 关闭刷新
+     *
+     * 通过 getOrLoad 命中的条目距上次写入超过 interval 时，先返回当前值，再把重新加载提交到
+     * 共享线程池；同一条目同时只有一个刷新，线程池队列已满时放弃本次刷新。刷新完成前条目被
+     * 重新写入或淘汰，刷新结果即被丢弃。刷新只替换值，条目的过期时刻和位置不变，不计入写入，
+     * 也不产生覆盖事件。开启前写入的条目视为需要刷新。
+     */
+    void setRefreshAfterWrite(std::chrono::milliseconds interval);
+
+    /**
+     * @brief 设置移除监听器，listener 为空时关闭
+     *
+     * 淘汰、过期、覆盖和 removeByKey 都会产生事件。事件在持锁时写入缓冲区，释放锁后由触发
+     * 移除的线程整批投递，或提交给 executor（队列满时退回当前线程投递）；executor 由调用方持有，
+     * 必须比缓存活得久。不使用 executor 时，同一线程产生的事件按移除顺序投递。
+     */
+    void setRemovalListener(RemovalListener<KeyType, ValueType> listener,
+                            ThreadPool*                         executor = nullptr);
+
+    // 计数之外，加读锁读取当前条目数和总权重
+    CacheStats stats() const override;
+
+    /**
+     * @brief 查询，未命中时调用 loader(key) 加载并写入缓存
+     *
+     * 同一个键的并发未命中只有一个线程执行 loader，其余线程等待并共享它的结果，值只写入一次；
+     * loader 抛出的异常会传给所有等待的线程，缓存不变。开启写后刷新时 loader 会被复制到后台
+     * 线程执行，必须可复制，且在缓存析构前保持可用；后台刷新抛出的异常被忽略，保留旧值。
+     */
+    template <typename Loader>
+    ValueType getOrLoad(const KeyType& key, Loader&& loader);
+
+    // 异构查找：如 std::string 键可直接用 std::string_view 查询，不构造临时键
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool get(const K& key, ValueType& result);
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool peek(const K& key, ValueType& result) const;
+    template <typename K, typename = std::enable_if_t<IsHeterogeneousKey<KeyType, K, Hasher>>>
+    bool contains(const K& key) const;
+
+    // 批量接口：整批只加一次锁
+    std::size_t getMany(const KeyType* keys, std::size_t count, ValueType* results,
+                        std::uint64_t* hitBits) override;
+    void        putMany(const KeyType* keys, const ValueType* values, std::size_t count) override;
 
     // 公开remove方法，供LRU-K等子类使用
-    void removeByKey(KeyType key);
-    void changeCapacity(int num);
+    void removeByKey(const KeyType& key);
+    void changeCapacity(std::int64_t num);
 
   protected:
+    // 以下单键接口的 hash 由调用方算好（须为 hashOf(key)），分片缓存选分片时算的哈希直接传入
+
+    // getOrLoad 未命中后的加载部分，分片缓存自己完成查询后调用
+    template <typename Loader>
+    ValueType load(const KeyType& key, std::size_t hash, Loader&& loader);
+    // getOrLoad 命中过旧条目后的刷新部分，把 loader 的副本提交到线程池
+    template <typename Loader>
+    void refresh(const KeyType& key, std::size_t hash, Loader&& loader);
+    // 放弃尚未开始的刷新并等待正在执行的刷新结束，重写了虚函数的子类应在析构时先调用
+    void stopRefresh();
+
+    /**
+     * @brief 查询的实现
+     * @param stale 不为空时检查写后刷新：条目需要刷新且没有刷新在进行时置为 true，
+     *              并把条目标记为刷新中，调用方必须随后调用 refresh
+     */
+    template <typename K>
+    bool getImpl(const K& key, std::size_t hash, ValueType& result, bool* stale = nullptr);
+    template <typename K>
+    bool peekImpl(const K& key, std::size_t hash, ValueType& result) const;
+    template <typename K>
+    bool containsImpl(const K& key, std::size_t hash) const;
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value, std::size_t hash);
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value, std::size_t hash, std::chrono::milliseconds ttl);
+
     virtual void removeLast();
     NodePtr      getLastNode();
-    void         remove(const NodePtr& node, bool removeMap = false);
+    void         remove(NodePtr node, bool removeMap = false);
 
     // 为子类提供的安全接口
     bool hasValidNodes() const { return nodeCount_ > 0; }
 
+    /**
+     * @brief 批量接口的实现，只处理 positions 指定下标的键，供分片缓存按分片分组后调用
+     * @param hashes keys[i] 的哈希，为空时现场计算
+     * @param positions 要处理的键下标，为空时处理 [0, count)
+     */
+    std::size_t getManyAt(const KeyType* keys, const std::size_t* hashes,
+                          const std::uint32_t* positions, std::size_t count, ValueType* results,
+                          std::uint64_t* hitBits);
+    void        putManyAt(const KeyType* keys, const ValueType* values, const std::size_t* hashes,
+                          const std::uint32_t* positions, std::size_t count);
+
+    // 索引使用的哈希，可先算一次再传给 findNode 和追踪
+    template <typename K>
+    std::size_t hashOf(const K& key) const
+    {
+        return map_.hashOf(key);
+    }
+
+    // 以下接口要求调用方已持有 mutex_（查找可为读锁，其余为写锁）
+    template <typename K>
+    NodePtr findNode(const K& key) const;
+    template <typename K>
+    NodePtr findNode(const K& key, std::size_t hash) const;
+    template <typename K, typename V>
+    void putLocked(K&& key, V&& value);
+    template <typename K, typename V>
+    void putLocked(K&& key, V&& value, std::size_t hash);
+    // expireAt 为过期时刻，0 表示永不过期
+    template <typename K, typename V>
+    void putLocked(K&& key, V&& value, std::size_t hash, std::int64_t expireAt);
+    // getManyAt/putManyAt 加锁之后的部分，参数相同
+    std::size_t getManyLocked(const KeyType* keys, const std::size_t* hashes,
+                              const std::uint32_t* positions, std::size_t count,
+                              ValueType* results, std::uint64_t* hitBits);
+    void        putManyLocked(const KeyType* keys, const ValueType* values,
+                              const std::size_t* hashes, const std::uint32_t* positions,
+                              std::size_t count);
+    void moveToFirst(NodePtr node);
+    bool expired(NodePtr node) const;
+    // 计入统计和追踪并记录移除事件，要在 remove 释放节点之前调用
+    void notifyRemoval(NodePtr node, RemovalCause cause);
+
   private:
-    void moveToFirst(const NodePtr& node);
-    void insertFirst(const NodePtr& node);
+    void insertFirst(NodePtr node);
+
+    // 以下接口要求调用方已持有写锁
+    std::int64_t deadline(std::int64_t ttl) const;
+    bool         refreshDue(NodePtr node) const;
+    // 推进时间轮，最多清理 kExpireBatch 个过期节点
+    void expireEntries();
+
+    // 后台刷新结束：条目仍在等待这次刷新时原地替换为 value（为空表示加载失败）并清除刷新标记
+    void finishRefresh(const KeyType& key, std::size_t hash, const ValueType* value);
 };
@@ -2,17 +2,211 @@
 
 #include "../../utils/log.hpp"
 #include "LRU.decl.hpp"
+#include <algorithm>
 
-template <typename KeyType, typename ValueType>
-LRUCache<KeyType, ValueType>::LRUCache(int capacity)
-    : capacity_(capacity), first_(std::make_shared<NodeType>()), last_(std::make_shared<NodeType>())
+template <typename KeyType, typename ValueType, typename Hasher>
+LRUCache<KeyType, ValueType, Hasher>::LRUCache(int capacity)
+    : LRUCache(capacity, Weigher<KeyType, ValueType>{})
 {
-    first_->next = last_;
-    last_->prev  = first_;
 }
 
-template <typename KeyType, typename ValueType>
-bool LRUCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
+template <typename KeyType, typename ValueType, typename Hasher>
+LRUCache<KeyType, ValueType, Hasher>::LRUCache(std::int64_t                capacity,
+                                               Weigher<KeyType, ValueType> weigher,
+                                               double                      admissionFraction)
+    : weights_(capacity, std::move(weigher), admissionFraction)
+    // 按权重计容量时条目数量未知，索引按需增长
+    , map_(weights_.weighted() ? 0 : static_cast<std::size_t>(std::max<std::int64_t>(capacity, 0)))
+    , pool_(static_cast<std::size_t>(std::clamp<std::int64_t>(capacity, 1, 4096)))
+{
+    first_.next = &last_;
+    last_.prev  = &first_;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+LRUCache<KeyType, ValueType, Hasher>::~LRUCache()
+{
+    // 刷新任务会访问缓存的所有成员，必须在任何成员析构之前停下
+    stopRefresh();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key, ValueType& result)
+{
+    return getImpl(key, map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool LRUCache<KeyType, ValueType, Hasher>::get(const K& key, ValueType& result)
+{
+    return getImpl(key, map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+ValueType LRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value, map_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value)
+{
+    std::size_t hash = map_.hashOf(key);
+    putImpl(std::move(key), std::move(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value,
+                                               std::chrono::milliseconds ttl)
+{
+    putImpl(key, value, map_.hashOf(key), ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value,
+                                               std::chrono::milliseconds ttl)
+{
+    std::size_t hash = map_.hashOf(key);
+    putImpl(std::move(key), std::move(value), hash, ttl);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::setDefaultTtl(std::chrono::milliseconds ttl)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    defaultTtl_ = ttl.count();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::setRefreshAfterWrite(std::chrono::milliseconds interval)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    refreshAfter_ = std::max<std::int64_t>(interval.count(), 0);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::setRemovalListener(
+    RemovalListener<KeyType, ValueType> listener, ThreadPool* executor)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    removals_.setListener(std::move(listener), executor);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+CacheStats LRUCache<KeyType, ValueType, Hasher>::stats() const
+{
+    CacheStats                          stats = this->stats_.snapshot();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    stats.size   = static_cast<std::size_t>(nodeCount_);
+    stats.weight = weights_.used();
+    return stats;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+ValueType LRUCache<KeyType, ValueType, Hasher>::getOrLoad(const KeyType& key, Loader&& loader)
+{
+    ValueType   result{};
+    bool        stale = false;
+    std::size_t hash  = map_.hashOf(key);
+    if (!getImpl(key, hash, result, &stale))
+        return load(key, hash, std::forward<Loader>(loader));
+    if (stale)
+        refresh(key, hash, std::forward<Loader>(loader));
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+ValueType LRUCache<KeyType, ValueType, Hasher>::load(const KeyType& key, std::size_t hash,
+                                                     Loader&& loader)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Load);
+    return loads_.run(key,
+                      hash,
+                      [&]
+                      {
+                          // 未命中到开始加载之间，上一次加载可能刚刚写入
+                          ValueType value{};
+                          if (peekImpl(key, hash, value))
+                              return value;
+                          value = loader(key);
+                          putImpl(key, value, hash);
+                          return value;
+                      });
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Loader>
+void LRUCache<KeyType, ValueType, Hasher>::refresh(const KeyType& key, std::size_t hash,
+                                                   Loader&& loader)
+{
+    bool submitted = refreshes_.submit(
+        [this, key, hash, loader = std::decay_t<Loader>(std::forward<Loader>(loader))]() mutable
+        {
+            ValueType value{};
+            try
+            {
+                value = loader(key);
+            }
+            catch (...)
+            {
+                log("(LRU refresh) load failed: ", key, '\n');
+                finishRefresh(key, hash, nullptr);
+                return;
+            }
+            finishRefresh(key, hash, &value);
+        });
+    // 线程池忙时放弃本次刷新，清除标记让之后的命中重新尝试
+    if (!submitted)
+        finishRefresh(key, hash, nullptr);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::stopRefresh()
+{
+    refreshes_.close();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LRUCache<KeyType, ValueType, Hasher>::peek(const KeyType& key, ValueType& result) const
+{
+    return peekImpl(key, map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool LRUCache<KeyType, ValueType, Hasher>::peek(const K& key, ValueType& result) const
+{
+    return peekImpl(key, map_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LRUCache<KeyType, ValueType, Hasher>::contains(const KeyType& key) const
+{
+    return containsImpl(key, map_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename>
+bool LRUCache<KeyType, ValueType, Hasher>::contains(const K& key) const
+{
+    return containsImpl(key, map_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool LRUCache<KeyType, ValueType, Hasher>::getImpl(const K& key, std::size_t hash,
+                                                   ValueType& result, bool* stale)
 {
     // 防御性检查：禁止空键值的查询
     // if (key == KeyType{})
@@ -21,29 +215,67 @@ bool LRUCache<KeyType, ValueType>::get(KeyType key, ValueType& result)
     //     return false;
     // }
 
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    if (map_.find(key) != map_.end())
+    LatencyScope timing(this->latency_.get(), LatencyOp::GetMiss);
+    WriteLock    lock(mutex_, removals_);
+    expireEntries();
+    if (NodePtr node = findNode(key, hash))
     {
-        NodePtr temp = map_[key];
-        moveToFirst(temp);
-        result = temp->value;
+        if (expired(node))
+        {
+            // 惰性过期：时间轮还没推进到的过期节点在查找时直接移除
+            notifyRemoval(node, RemovalCause::Expired);
+            remove(node, true);
+            this->stats_.miss();
+            this->trace(TraceOp::GetMiss, hash);
+            log("(LRU get) expired: ", key, '\n');
+            return false;
+        }
+        this->stats_.hit();
+        this->trace(TraceOp::GetHit, hash);
+        timing.setOp(LatencyOp::GetHit);
+        moveToFirst(node);
+        result = node->value;
+        if (stale && refreshDue(node))
+        {
+            meta_.setRefreshing(node, true);
+            *stale = true;
+        }
         log("(LRU get) get: ", key, " = ", result, '\n');
         return true;
     }
+    this->stats_.miss();
+    this->trace(TraceOp::GetMiss, hash);
     log("(LRU get) get failed: ", key, '\n');
     return false;
 }
 
-template <typename KeyType, typename ValueType>
-ValueType LRUCache<KeyType, ValueType>::get(KeyType key)
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool LRUCache<KeyType, ValueType, Hasher>::peekImpl(const K& key, std::size_t hash,
+                                                    ValueType& result) const
 {
-    ValueType result{};
-    get(key, result);
-    return result;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    NodePtr                             node = findNode(key, hash);
+    if (node && !expired(node))
+    {
+        result = node->value;
+        return true;
+    }
+    return false;
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::put(KeyType key, ValueType value)
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+bool LRUCache<KeyType, ValueType, Hasher>::containsImpl(const K& key, std::size_t hash) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    NodePtr                             node = findNode(key, hash);
+    return node && !expired(node);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LRUCache<KeyType, ValueType, Hasher>::putImpl(K&& key, V&& value, std::size_t hash)
 {
     // 防御性检查：禁止空键值的插入
     // if (key == KeyType{})
@@ -52,99 +284,375 @@ void LRUCache<KeyType, ValueType>::put(KeyType key, ValueType value)
     //     return;
     // }
 
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    if (map_.find(key) != map_.end())
+    LatencyScope timing(this->latency_.get(), LatencyOp::Put);
+    WriteLock    lock(mutex_, removals_);
+    putLocked(std::forward<K>(key), std::forward<V>(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LRUCache<KeyType, ValueType, Hasher>::putImpl(K&& key, V&& value, std::size_t hash,
+                                                   std::chrono::milliseconds ttl)
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Put);
+    WriteLock    lock(mutex_, removals_);
+    putLocked(std::forward<K>(key), std::forward<V>(value), hash, deadline(ttl.count()));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t LRUCache<KeyType, ValueType, Hasher>::getMany(const KeyType* keys,
+                                                          std::size_t    count,
+                                                          ValueType*     results,
+                                                          std::uint64_t* hitBits)
+{
+    this->clearHitBits(hitBits, count);
+    return getManyAt(keys, nullptr, nullptr, count, results, hitBits);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::putMany(const KeyType* keys, const ValueType* values,
+                                                   std::size_t count)
+{
+    putManyAt(keys, values, nullptr, nullptr, count);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t LRUCache<KeyType, ValueType, Hasher>::getManyAt(const KeyType*       keys,
+                                                            const std::size_t*   hashes,
+                                                            const std::uint32_t* positions,
+                                                            std::size_t          count,
+                                                            ValueType*           results,
+                                                            std::uint64_t*       hitBits)
+{
+    WriteLock lock(mutex_, removals_);
+    return getManyLocked(keys, hashes, positions, count, results, hitBits);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::size_t LRUCache<KeyType, ValueType, Hasher>::getManyLocked(const KeyType*       keys,
+                                                                const std::size_t*   hashes,
+                                                                const std::uint32_t* positions,
+                                                                std::size_t          count,
+                                                                ValueType*           results,
+                                                                std::uint64_t*       hitBits)
+{
+    // 分组流水线：一组键依次经过 哈希->预取槽位、查找->预取节点、预取相邻节点、完成访问，
+    // 每一轮发出的预取在下一轮用到之前已经在途，一组内各键的内存延迟相互重叠
+    std::size_t hits = 0;
+    std::size_t groupIndex[kPrefetchGroup];
+    std::size_t groupHashes[kPrefetchGroup];
+    NodePtr     groupNodes[kPrefetchGroup];
+    expireEntries();
+    for (std::size_t begin = 0; begin < count; begin += kPrefetchGroup)
+    {
+        std::size_t size = std::min(kPrefetchGroup, count - begin);
+        for (std::size_t n = 0; n < size; n++)
+        {
+            std::size_t i  = positions ? positions[begin + n] : begin + n;
+            groupIndex[n]  = i;
+            groupHashes[n] = hashes ? hashes[i] : map_.hashOf(keys[i]);
+            map_.prefetch(groupHashes[n]);
+        }
+        for (std::size_t n = 0; n < size; n++)
+        {
+            groupNodes[n] = findNode(keys[groupIndex[n]], groupHashes[n]);
+            if (groupNodes[n])
+                prefetchWrite(groupNodes[n]);
+        }
+        // 移到表头要修改前后相邻节点
+        for (std::size_t n = 0; n < size; n++)
+        {
+            if (NodePtr node = groupNodes[n])
+            {
+                prefetchWrite(node->prev);
+                prefetchWrite(node->next);
+            }
+        }
+        for (std::size_t n = 0; n < size; n++)
+        {
+            // 过期节点按未命中处理，留给时间轮回收：同一组内可能有重复的键，这里不能释放节点
+            NodePtr node = groupNodes[n];
+            if (!node || expired(node))
+            {
+                this->trace(TraceOp::GetMiss, groupHashes[n]);
+                continue;
+            }
+            this->trace(TraceOp::GetHit, groupHashes[n]);
+            moveToFirst(node);
+            results[groupIndex[n]] = node->value;
+            this->setHitBit(hitBits, groupIndex[n]);
+            hits++;
+        }
+    }
+    this->stats_.hit(hits);
+    this->stats_.miss(count - hits);
+    return hits;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::putManyAt(const KeyType*       keys,
+                                                     const ValueType*     values,
+                                                     const std::size_t*   hashes,
+                                                     const std::uint32_t* positions,
+                                                     std::size_t          count)
+{
+    WriteLock lock(mutex_, removals_);
+    putManyLocked(keys, values, hashes, positions, count);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::putManyLocked(const KeyType*       keys,
+                                                         const ValueType*     values,
+                                                         const std::size_t*   hashes,
+                                                         const std::uint32_t* positions,
+                                                         std::size_t          count)
+{
+    for (std::size_t n = 0; n < count; n++)
+    {
+        std::size_t i = positions ? positions[n] : n;
+        putLocked(keys[i], values[i], hashes ? hashes[i] : map_.hashOf(keys[i]));
+    }
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+typename LRUCache<KeyType, ValueType, Hasher>::NodePtr
+LRUCache<KeyType, ValueType, Hasher>::findNode(const K& key) const
+{
+    const NodePtr* slot = map_.find(key);
+    return slot ? *slot : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K>
+typename LRUCache<KeyType, ValueType, Hasher>::NodePtr
+LRUCache<KeyType, ValueType, Hasher>::findNode(const K& key, std::size_t hash) const
+{
+    const NodePtr* slot = map_.find(key, hash);
+    return slot ? *slot : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LRUCache<KeyType, ValueType, Hasher>::putLocked(K&& key, V&& value)
+{
+    std::size_t hash = map_.hashOf(key);
+    putLocked(std::forward<K>(key), std::forward<V>(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LRUCache<KeyType, ValueType, Hasher>::putLocked(K&& key, V&& value, std::size_t hash)
+{
+    putLocked(std::forward<K>(key), std::forward<V>(value), hash, deadline(defaultTtl_));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void LRUCache<KeyType, ValueType, Hasher>::putLocked(K&& key, V&& value, std::size_t hash,
+                                                     std::int64_t expireAt)
+{
+    expireEntries();
+    this->stats_.put();
+
+    std::int64_t weight = weights_.weigh(key, value);
+    if (NodePtr* slot = map_.find(key, hash))
     {
-        NodePtr node = map_[key];
-        node->value  = value;
+        NodePtr node = *slot;
+        if (!weights_.admits(weight))
+        {
+            // 新值过大不能写入，也不能留下已过期的旧值
+            log("(LRU put) rejected: ", key, ", weight ", weight, '\n');
+            notifyRemoval(node, RemovalCause::Size);
+            remove(node, true);
+            return;
+        }
+        notifyRemoval(node, RemovalCause::Replaced);
+        weights_.charge(weight - meta_.weightOf(node));
+        node->value = std::forward<V>(value);
         moveToFirst(node);
-        log("(LRU put) update: ", key, '=', value, '\n');
+        // 正在进行的刷新结果比这次写入旧，完成时丢弃
+        meta_.assign(node, weight, refreshAfter_ > 0 ? CoarseClock::now() : 0, expireAt);
+        log("(LRU put) update: ", key, '=', node->value, '\n');
+
+        // 新值变重时从表尾淘汰，刚更新的节点在表头，最后才会轮到
+        while (nodeCount_ > 1 && weights_.overflows(0)) removeLast();
+        return;
+    }
+    if (!weights_.admits(weight))
+    {
+        this->trace(TraceOp::Reject, hash);
+        log("(LRU put) rejected: ", key, ", weight ", weight, '\n');
         return;
     }
+    this->trace(TraceOp::Insert, hash);
     log("(LRU put) new put: ", key, '=', value, '\n');
 
-    if (nodeCount_ < capacity_)
-        nodeCount_++;
-    else
-        removeLast();
+    // 淘汰到能容纳新节点为止（remove 会减少 nodeCount_ 并归还权重），再计入新节点
+    while (nodeCount_ > 0 && weights_.overflows(weight)) removeLast();
+    nodeCount_++;
+    weights_.charge(weight);
 
-    auto node = std::make_shared<NodeType>(key, value);
-    map_[key] = node;
+    NodePtr node = pool_.acquire();
+    node->key    = std::forward<K>(key);
+    node->value  = std::forward<V>(value);
+    node->hash   = hash;
+    map_.insert(hash, node);
     insertFirst(node);
+    meta_.assign(node, weight, refreshAfter_ > 0 ? CoarseClock::now() : 0, expireAt);
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::removeByKey(KeyType key)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::removeByKey(const KeyType& key)
 {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    auto                                it = map_.find(key);
-    if (it != map_.end())
+    WriteLock lock(mutex_, removals_);
+    if (NodePtr* slot = map_.find(key))
     {
-        remove(it->second, true);
-        nodeCount_--;
+        notifyRemoval(*slot, RemovalCause::Explicit);
+        remove(*slot, true);
     }
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::changeCapacity(int num)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::changeCapacity(std::int64_t num)
 {
-    capacity_ += num;
-
-    // 确保容量不会变为0或负数
-    if (capacity_ < 1)
-    {
-        capacity_ = 1;
-    }
+    WriteLock lock(mutex_, removals_);
+    // 容量不会变为0或负数
+    weights_.resize(num);
 
-    // 只有当确实有超出容量的节点时才移除
-    while (nodeCount_ > capacity_ && nodeCount_ > 0) { removeLast(); }
+    // 只有当确实超出容量时才移除
+    while (nodeCount_ > 0 && weights_.overflows(0)) { removeLast(); }
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::moveToFirst(const NodePtr& node)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::moveToFirst(NodePtr node)
 {
     remove(node);
     insertFirst(node);
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::removeLast()
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::notifyRemoval(NodePtr node, RemovalCause cause)
+{
+    this->stats_.removal(cause);
+    this->trace(cause, node->hash);
+    removals_.record(node->key, std::move(node->value), cause);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::removeLast()
 {
     if (nodeCount_ <= 0)
         return;
-    remove(getLastNode(), true);
+    LatencyScope timing(this->latency_.get(), LatencyOp::Evict);
+    NodePtr      node = getLastNode();
+    notifyRemoval(node, RemovalCause::Size);
+    remove(node, true);
 }
 
-template <typename KeyType, typename ValueType>
-typename LRUCache<KeyType, ValueType>::NodePtr LRUCache<KeyType, ValueType>::getLastNode()
+template <typename KeyType, typename ValueType, typename Hasher>
+typename LRUCache<KeyType, ValueType, Hasher>::NodePtr
+LRUCache<KeyType, ValueType, Hasher>::getLastNode()
 {
-    auto node = last_->prev.lock();
+    NodePtr node = last_.prev;
 
-    if (node && map_.find(node->key) != map_.end())
+    if (node != &first_)
         return node;
 
     return nullptr;
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::remove(const NodePtr& node, const bool removeMap)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::remove(NodePtr node, const bool removeMap)
 {
-    node->prev.lock()->next = node->next;
-    node->next->prev        = node->prev.lock();
-    node->next              = nullptr;
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev       = nullptr;
+    node->next       = nullptr;
 
     if (removeMap)
     {
         nodeCount_--;
-        map_.erase(node->key);
+        weights_.discharge(meta_.release(node));
+        map_.erase(node->key, node->hash);
+        pool_.release(node);
     }
 }
 
-template <typename KeyType, typename ValueType>
-void LRUCache<KeyType, ValueType>::insertFirst(const NodePtr& node)
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::insertFirst(NodePtr node)
+{
+    node->prev        = &first_;
+    node->next        = first_.next;
+    first_.next->prev = node;
+    first_.next       = node;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LRUCache<KeyType, ValueType, Hasher>::expired(NodePtr node) const
+{
+    // 没有节点带附加信息时只判断一次旁路表为空，不使用 ttl 时查找路径没有额外开销
+    return meta_.expired(node);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool LRUCache<KeyType, ValueType, Hasher>::refreshDue(NodePtr node) const
+{
+    return refreshAfter_ > 0 && meta_.refreshDue(node, refreshAfter_);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+std::int64_t LRUCache<KeyType, ValueType, Hasher>::deadline(std::int64_t ttl) const
+{
+    return ttl > 0 ? CoarseClock::now() + ttl : 0;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::expireEntries()
+{
+    if (meta_.timersEmpty())
+        return;
+    LatencyScope timing(this->latency_.get(), LatencyOp::Maintenance);
+    std::size_t  expired = meta_.expire(CoarseClock::now(),
+                                        kExpireBatch,
+                                        [this](NodePtr node)
+                                        {
+                                            notifyRemoval(node, RemovalCause::Expired);
+                                            remove(node, true);
+                                        });
+    // 没有节点过期的推进不计入维护延迟
+    if (expired == 0)
+        timing.dismiss();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void LRUCache<KeyType, ValueType, Hasher>::finishRefresh(const KeyType& key, std::size_t hash,
+                                                         const ValueType* value)
 {
-    node->prev         = first_;
-    node->next         = first_->next;
-    first_->next->prev = node;
-    first_->next       = node;
+    WriteLock lock(mutex_, removals_);
+    NodePtr   node = findNode(key, hash);
+    // 刷新期间条目被淘汰（附加记录随节点回收）或被重新写入，这次刷新已经过时
+    if (!node || !meta_.refreshing(node))
+        return;
+    if (!value)
+    {
+        meta_.setRefreshing(node, false);
+        return;
+    }
+
+    // 刷新不是用户写入：只替换值，过期时刻和链表位置不变，不计入写入也不产生覆盖事件
+    std::int64_t weight = weights_.weigh(key, *value);
+    if (!weights_.admits(weight))
+    {
+        log("(LRU refresh) rejected: ", key, ", weight ", weight, '\n');
+        notifyRemoval(node, RemovalCause::Size);
+        remove(node, true);
+        return;
+    }
+    weights_.charge(weight - meta_.weightOf(node));
+    node->value = *value;
+    meta_.refreshed(node, weight, refreshAfter_ > 0 ? CoarseClock::now() : 0);
+
+    // 新值变重时从表尾淘汰，节点不在表头，自身也可能被淘汰
+    while (nodeCount_ > 0 && weights_.overflows(0)) removeLast();
 }
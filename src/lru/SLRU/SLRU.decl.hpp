@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../../common/BaseCache.hpp"
+#include "../../common/FlatMap.hpp"
+#include "../../common/Hash.hpp"
+#include "../../common/IntrusiveList.hpp"
+#include "../../common/Node.hpp"
+#include "../../common/NodePool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief 分段 LRU 缓存（2Q 算法）
+ *
+ * 新条目进入试用段 A1in（FIFO，命中不调整顺序），被挤出 A1in 的键记入幽灵队列 A1out（只保存键）；
+ * 键在 A1out 中再次被 put 时说明它不是一次性访问，直接进入保护段 Am（LRU）。
+ * 只访问一次的扫描数据只会在 A1in 中流过，不会冲掉 Am 中的热点数据。
+ */
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHash<KeyType>>
+class SLRUCache : public BaseCache<KeyType, ValueType>
+{
+    using NodeType  = Node<KeyType, ValueType>;
+    using NodePtr   = NodeType*;
+    using GhostType = GhostNode<KeyType>;
+    using GhostPtr  = GhostType*;
+
+    enum class Segment : std::uint8_t
+    {
+        Probation, // 试用段 A1in
+        Protected, // 保护段 Am
+        Ghost,     // 幽灵队列 A1out
+    };
+
+    struct Entry
+    {
+        NodePtr  node{nullptr};  // A1in/Am 中的节点
+        GhostPtr ghost{nullptr}; // A1out 中的幽灵记录
+        Segment  segment{Segment::Probation};
+    };
+
+    // 索引的取键方式：键存放在节点或幽灵记录中，索引槽位不另存一份
+    struct EntryKey
+    {
+        const KeyType& operator()(const Entry& entry) const
+        {
+            return entry.node ? entry.node->key : entry.ghost->key;
+        }
+    };
+
+    using EntryMap = FlatMap<KeyType, Entry, Hasher, std::equal_to<>, EntryKey>;
+
+    int capacity_;          // 缓存容量（A1in + Am）
+    int probationCapacity_; // A1in 的容量
+    int ghostCapacity_;     // A1out 的容量
+
+    IntrusiveList<NodeType>  probation_; // A1in
+    IntrusiveList<NodeType>  protected_; // Am
+    IntrusiveList<GhostType> ghosts_;    // A1out
+    EntryMap                 index_;     // key->所在段及节点
+    NodePool<NodeType>       pool_;      // 缓存节点池
+    NodePool<GhostType>      ghostPool_; // 幽灵记录池
+    mutable std::mutex       mutex_;     // 命中也会调整链表，使用互斥锁
+
+  public:
+    /**
+     * @param capacity 缓存容量
+     * @param probation_percent A1in 占缓存容量的百分比
+     * @param ghost_percent A1out 记录的键数量占缓存容量的百分比
+     */
+    SLRUCache(int capacity, int probation_percent = 25, int ghost_percent = 50);
+
+    bool      get(const KeyType& key, ValueType& result) override;
+    ValueType get(const KeyType& key) override;
+    void      put(const KeyType& key, const ValueType& value) override;
+    void      put(KeyType&& key, ValueType&& value) override;
+    bool      peek(const KeyType& key, ValueType& result) const override;
+    bool      contains(const KeyType& key) const override;
+
+    // 2Q 的 ghostHits 是 A1out 中的键再次写入、直接进入 Am 的次数
+    CacheStats stats() const override;
+
+  protected:
+    // 单键接口的实现，hash 为 Hasher{}(key)，分片缓存选分片时算好后直接传入
+    bool getImpl(const KeyType& key, std::size_t hash, ValueType& result);
+    bool peekImpl(const KeyType& key, std::size_t hash, ValueType& result) const;
+    bool containsImpl(const KeyType& key, std::size_t hash) const;
+    template <typename K, typename V>
+    void putImpl(K&& key, V&& value, std::size_t hash);
+
+  private:
+
+    /**
+     * @brief 缓存已满时腾出一个位置：A1in 超出容量则淘汰到 A1out，否则淘汰 Am 最久未访问的条目
+     */
+    void reclaim();
+};
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "SLRU.decl.hpp"
+#include "SLRU.impl.hpp"
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../../utils/log.hpp"
+#include "SLRU.decl.hpp"
+#include <algorithm>
+
+template <typename KeyType, typename ValueType, typename Hasher>
+SLRUCache<KeyType, ValueType, Hasher>::SLRUCache(int capacity, int probation_percent,
+                                                 int ghost_percent)
+    : capacity_(std::max(capacity, 1))
+    , probationCapacity_(std::max(capacity_ * probation_percent / 100, 1))
+    , ghostCapacity_(std::max(capacity_ * ghost_percent / 100, 1))
+    , index_(capacity_ + ghostCapacity_)
+    , pool_(std::clamp(capacity_, 1, 4096))
+    , ghostPool_(std::clamp(ghostCapacity_, 1, 4096))
+{
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool SLRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key, ValueType& result)
+{
+    return getImpl(key, index_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+ValueType SLRUCache<KeyType, ValueType, Hasher>::get(const KeyType& key)
+{
+    ValueType result{};
+    get(key, result);
+    return result;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void SLRUCache<KeyType, ValueType, Hasher>::put(const KeyType& key, const ValueType& value)
+{
+    putImpl(key, value, index_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void SLRUCache<KeyType, ValueType, Hasher>::put(KeyType&& key, ValueType&& value)
+{
+    std::size_t hash = index_.hashOf(key);
+    putImpl(std::move(key), std::move(value), hash);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool SLRUCache<KeyType, ValueType, Hasher>::peek(const KeyType& key, ValueType& result) const
+{
+    return peekImpl(key, index_.hashOf(key), result);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool SLRUCache<KeyType, ValueType, Hasher>::contains(const KeyType& key) const
+{
+    return containsImpl(key, index_.hashOf(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool SLRUCache<KeyType, ValueType, Hasher>::getImpl(const KeyType& key, std::size_t hash,
+                                                    ValueType& result)
+{
+    LatencyScope                timing(this->latency_.get(), LatencyOp::GetMiss);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Entry* entry = index_.find(key, hash);
+    if (!entry || entry->segment == Segment::Ghost)
+    {
+        this->stats_.miss();
+        log("(SLRU get) get failed: ", key, '\n');
+        return false;
+    }
+    this->stats_.hit();
+    timing.setOp(LatencyOp::GetHit);
+
+    // A1in 是 FIFO，命中不调整顺序，短时间内的重复访问不会让条目晋升
+    if (entry->segment == Segment::Protected)
+        protected_.moveToFront(entry->node);
+
+    result = entry->node->value;
+    log("(SLRU get) get: ", key, " = ", result, '\n');
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool SLRUCache<KeyType, ValueType, Hasher>::peekImpl(const KeyType& key, std::size_t hash,
+                                                     ValueType& result) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry*                entry = index_.find(key, hash);
+    if (!entry || !entry->node)
+        return false;
+    result = entry->node->value;
+    return true;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+bool SLRUCache<KeyType, ValueType, Hasher>::containsImpl(const KeyType& key, std::size_t hash) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry*                entry = index_.find(key, hash);
+    return entry && entry->node;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+CacheStats SLRUCache<KeyType, ValueType, Hasher>::stats() const
+{
+    CacheStats                  stats = this->stats_.snapshot();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.size   = static_cast<std::size_t>(probation_.size() + protected_.size());
+    stats.weight = static_cast<std::int64_t>(stats.size);
+    return stats;
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename K, typename V>
+void SLRUCache<KeyType, ValueType, Hasher>::putImpl(K&& key, V&& value, std::size_t hash)
+{
+    LatencyScope                timing(this->latency_.get(), LatencyOp::Put);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Entry* entry = index_.find(key, hash);
+    this->stats_.put();
+    if (entry && entry->node)
+    {
+        this->stats_.removal(RemovalCause::Replaced);
+        log("(SLRU put) update: ", key, '=', value, '\n');
+        entry->node->value = std::forward<V>(value);
+        if (entry->segment == Segment::Protected)
+            protected_.moveToFront(entry->node);
+        return;
+    }
+
+    if (probation_.size() + protected_.size() >= capacity_)
+    {
+        reclaim();
+        // reclaim 可能增删索引条目（包括这个键的幽灵记录），需要重新查找
+        entry = index_.find(key, hash);
+    }
+
+    NodePtr node = pool_.acquire();
+    node->key    = std::forward<K>(key);
+    node->value  = std::forward<V>(value);
+    node->hash   = hash;
+
+    if (entry)
+    {
+        // A1out 命中：键被淘汰后又被访问，直接进入 Am
+        log("(SLRU put) ghost hit, promote: ", node->key, '\n');
+        this->stats_.ghostHit();
+        GhostPtr ghost = entry->ghost;
+        entry->node    = node;
+        entry->ghost   = nullptr;
+        entry->segment = Segment::Protected;
+        ghosts_.unlink(ghost);
+        ghostPool_.release(ghost);
+        protected_.pushFront(node);
+        return;
+    }
+
+    log("(SLRU put) new put: ", node->key, '=', node->value, '\n');
+    index_.insert(hash, Entry{node, nullptr, Segment::Probation});
+    probation_.pushFront(node);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void SLRUCache<KeyType, ValueType, Hasher>::reclaim()
+{
+    LatencyScope timing(this->latency_.get(), LatencyOp::Evict);
+    this->stats_.removal(RemovalCause::Size);
+    if (probation_.size() > probationCapacity_ || protected_.empty())
+    {
+        // A1in 的尾部淘汰到 A1out，只保留键
+        NodePtr victim = probation_.back();
+        log("(SLRU reclaim) move to A1out: ", victim->key, '\n');
+        probation_.unlink(victim);
+
+        if (ghosts_.size() >= ghostCapacity_)
+        {
+            GhostPtr oldest = ghosts_.back();
+            ghosts_.unlink(oldest);
+            index_.erase(oldest->key, oldest->hash);
+            ghostPool_.release(oldest);
+        }
+
+        // 索引从节点取键，要在键移到幽灵记录之前找到条目
+        Entry*   entry = index_.find(victim->key, victim->hash);
+        GhostPtr ghost = ghostPool_.acquire();
+        ghost->hash    = victim->hash;
+        ghost->key     = std::move(victim->key);
+        ghosts_.pushFront(ghost);
+
+        entry->node    = nullptr;
+        entry->ghost   = ghost;
+        entry->segment = Segment::Ghost;
+        pool_.release(victim);
+    }
+    else
+    {
+        NodePtr victim = protected_.back();
+        log("(SLRU reclaim) evict from Am: ", victim->key, '\n');
+        protected_.unlink(victim);
+        index_.erase(victim->key, victim->hash);
+        pool_.release(victim);
+    }
+}
@@ -1,3 +1,7 @@
+#include "BufferedLRU/BufferedLRU.hpp"
+#include "Clock/Clock.hpp"
 #include "HashLRU/HashLRU.hpp"
-#include "LRU-K/LRU-K.hpp"
-#include "LRU/LRU.hpp"
\ No newline at end of file
+#include "HashSLRU/HashSLRU.hpp"
+#include "LRU-k/LRU-K.hpp"
+#include "LRU/LRU.hpp"
+#include "SLRU/SLRU.hpp"
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "test/test.hpp"
 #include "utils/log.hpp"
+#include "utils/trace.hpp"
 
 #include <iostream>
 
@@ -8,14 +9,16 @@ int main(int argc, char* argv[])
     // 检查调试模式
     if (argc > 1 && std::string(argv[1]) == "-d")
     {
-        log("启用调试模式");
         DEBUG = true;
+        if constexpr (kLogLevel < CACHE_LOG_DEBUG)
+            std::cout << "调试日志未编译，请以 -DCACHE_LOG_LEVEL=3 重新构建" << std::endl;
+        log("启用调试模式\n");
     }
     else
         DEBUG = false;
 
     std::cout << "🔧 缓存系统性能测试程序" << std::endl;
-    std::cout << "\n🎯 本程序将对比以下6种缓存淘汰算法的性能表现:" << std::endl;
+    std::cout << "\n🎯 本程序将对比以下10种缓存淘汰算法的性能表现:" << std::endl;
     std::cout << "\n📋 测试指标包括:" << std::endl;
     std::cout << "  • 命中率 (Hit Rate) - 缓存命中的百分比" << std::endl;
     std::cout << "  • 执行时间 (Execution Time) - 算法执行耗时" << std::endl;
@@ -24,6 +27,13 @@ int main(int argc, char* argv[])
     // 运行综合性能测试
     runAllPerformanceTests();
 
+    if constexpr (kTraceEnabled)
+    {
+        // 各线程缓冲区只保留最近的事件，导出的是测试末尾的一段
+        if (Tracer::instance().dump("cache_trace.bin"))
+            std::cout << "\n🔍 追踪事件已写入 cache_trace.bin，可用 TraceDump 查看" << std::endl;
+    }
+
     std::cout << "\n✅ 程序执行完成！" << std::endl;
 
     return 0;
@@ -0,0 +1,275 @@
+// 行为测试：逐项检查缓存的语义（淘汰顺序、事件、过期、并发加载等），任一检查失败时返回非零
+#include "../arc/arc.hpp"
+#include "../lfu/lfu.hpp"
+#include "../lru/lru.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using Event = std::tuple<int, int, RemovalCause>; // 监听器收到的 (键, 值, 原因)
+
+static int g_failures = 0;
+
+// 发布构建定义了 NDEBUG，assert 会被编译掉，这里用自己的检查宏
+#define CHECK(condition)                                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(condition))                                                                          \
+        {                                                                                          \
+            g_failures++;                                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": 检查失败: " #condition << std::endl;  \
+        }                                                                                          \
+    } while (0)
+
+// 一次幽灵往返（get 命中 B1 后 put 同一个键）只调整一次 p
+static void testAdaptiveArcGhostRoundTrip()
+{
+    AdaptiveARCCache<int, int> cache(2);
+    cache.setStatsEnabled(true);
+    cache.put(1, 1);
+    cache.get(1); // 1 进入 T2
+    cache.put(2, 2);
+    cache.put(3, 3); // T1 已达 p=0，淘汰 2 进入 B1
+    CHECK(!cache.contains(2));
+    CHECK(cache.target() == 0);
+
+    int value = 0;
+    CHECK(!cache.get(2, value)); // 幽灵命中只算未命中，不调整 p
+    CHECK(cache.target() == 0);
+    cache.put(2, 2); // B1 命中：p 增加 max(|B2| / |B1|, 1) = 1
+    CHECK(cache.target() == 1);
+    CHECK(cache.get(2, value) && value == 2);
+    CHECK(cache.stats().ghostHits == 1);
+}
+
+// 覆盖、淘汰、删除、过期各产生一个事件，同步投递时按移除的顺序到达
+static void testListenerCauseAndOrder()
+{
+    LRUCache<int, int> cache(2);
+    std::vector<Event> events;
+    cache.setRemovalListener([&](const int& key, const int& value, RemovalCause cause)
+                             { events.emplace_back(key, value, cause); });
+
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(1, 10); // 覆盖，事件中是旧值
+    cache.put(3, 3);  // 淘汰表尾的 2
+    cache.removeByKey(1);
+    cache.put(4, 4, 1ms);
+    std::this_thread::sleep_for(50ms);
+    cache.put(5, 5); // 写入时推进时间轮，回收过期的 4
+
+    std::vector<Event> expected = {{1, 1, RemovalCause::Replaced},
+                                   {2, 2, RemovalCause::Size},
+                                   {1, 10, RemovalCause::Explicit},
+                                   {4, 4, RemovalCause::Expired}};
+    CHECK(events == expected);
+}
+
+// 监听器在锁外执行，可以读写同一个缓存，再次触发的淘汰照常投递
+static void testListenerReentry()
+{
+    LRUCache<int, int> cache(2);
+    std::vector<int>   evicted;
+    bool               visible = true;
+    cache.setRemovalListener(
+        [&](const int& key, const int&, RemovalCause cause)
+        {
+            if (cause != RemovalCause::Size)
+                return;
+            evicted.push_back(key);
+            if (key == 1)
+            {
+                visible = cache.contains(1);
+                cache.put(9, 9); // 淘汰 2，在这次投递中嵌套投递
+            }
+        });
+
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    CHECK(!visible);
+    CHECK((evicted == std::vector<int>{1, 2}));
+    CHECK(cache.contains(3) && cache.contains(9));
+}
+
+// ARC 中淘汰进幽灵列表的条目仍可查到，从幽灵列表淘汰时才算移除；幽灵命中不产生事件
+static void testArcListener()
+{
+    ARCCache<int, int> cache(1, 10);
+    std::vector<Event> events;
+    cache.setRemovalListener([&](const int& key, const int& value, RemovalCause cause)
+                             { events.emplace_back(key, value, cause); });
+
+    cache.put(1, 1);
+    cache.put(2, 2); // 1 进入幽灵列表
+    CHECK(events.empty());
+    cache.put(3, 3); // 2 进入幽灵列表，挤出 1
+    cache.put(3, 30);
+    std::vector<Event> expected = {{1, 1, RemovalCause::Size}, {3, 3, RemovalCause::Replaced}};
+    CHECK(events == expected);
+
+    ARCCache<int, int> ghostHit(2, 10);
+    events.clear();
+    ghostHit.setRemovalListener([&](const int& key, const int& value, RemovalCause cause)
+                                { events.emplace_back(key, value, cause); });
+    ghostHit.put(1, 1);
+    ghostHit.put(2, 2);
+    ghostHit.put(3, 3); // 1 进入幽灵列表
+    int value = 0;
+    CHECK(ghostHit.get(1, value) && value == 1); // 移回 LFU 部分
+    CHECK(events.empty());
+}
+
+// 同一个键的并发未命中只执行一次 loader，所有线程拿到同一个值
+template <typename Cache>
+static void testSingleFlight(Cache& cache)
+{
+    constexpr int            kThreads = 8;
+    std::atomic<int>         loads{0};
+    std::atomic<bool>        go{false};
+    std::vector<int>         results(kThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i)
+        threads.emplace_back(
+            [&, i]
+            {
+                while (!go.load()) std::this_thread::yield();
+                results[i] = cache.getOrLoad(7,
+                                             [&](const int& key)
+                                             {
+                                                 loads++;
+                                                 std::this_thread::sleep_for(50ms);
+                                                 return key * 6;
+                                             });
+            });
+    go = true;
+    for (std::thread& thread : threads) thread.join();
+
+    CHECK(loads == 1);
+    CHECK(std::count(results.begin(), results.end(), 42) == kThreads);
+}
+
+// 过期的条目立即不可见，其余条目不受影响
+template <typename Cache>
+static void testTtlExpiry(Cache& cache)
+{
+    cache.put(1, 1, 50ms);
+    cache.put(2, 2);
+    int value = 0;
+    CHECK(cache.get(1, value) && value == 1);
+
+    std::this_thread::sleep_for(100ms);
+    CHECK(!cache.get(1, value));
+    CHECK(!cache.peek(1, value));
+    CHECK(!cache.contains(1));
+    CHECK(cache.get(2, value) && value == 2);
+}
+
+// LRU-K 的批量接口和单键接口一样经过访问历史，达到 k 次才进入主缓存
+static void testLruKBatchAdmission()
+{
+    LRUKCache<int, int> once(2, 10, 10);
+    int                 key = 1, value = 1;
+    once.putMany(&key, &value, 1);
+    CHECK(!once.contains(1));
+
+    LRUKCache<int, int> cache(3, 10, 10);
+    std::uint64_t       hitBits = 0;
+    for (int i = 0; i < 3; ++i) cache.getMany(&key, 1, &value, &hitBits); // 三次未命中计入历史
+    cache.put(1, 1);
+    CHECK(cache.contains(1));
+}
+
+// 读缓冲 LRU 的批量写入先回放读缓冲，按最新的访问顺序淘汰
+static void testBufferedBatchDrains()
+{
+    BufferedLRUCache<int, int> cache(2, 1);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    int value = 0;
+    cache.get(1, value); // 只记录在读缓冲中
+    int key = 3;
+    value   = 3;
+    cache.putMany(&key, &value, 1);
+    CHECK(cache.contains(1));
+    CHECK(!cache.contains(2));
+}
+
+// 后台刷新只替换值：条目保留自己的 ttl，不计入写入，也不产生覆盖事件
+template <typename Cache>
+static void testRefreshKeepsTtl(Cache& cache)
+{
+    std::mutex                mutex;
+    std::vector<RemovalCause> causes;
+    cache.setStatsEnabled(true);
+    cache.setRemovalListener(
+        [&](const int&, const int&, RemovalCause cause)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            causes.push_back(cause);
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    cache.put(1, 1, 200ms);
+    cache.setRefreshAfterWrite(10ms);
+    std::this_thread::sleep_until(start + 30ms);
+    CHECK(cache.getOrLoad(1, [](const int&) { return 2; }) == 1); // 先返回旧值，再后台刷新
+
+    int value = 0;
+    for (int i = 0; i < 100 && !(cache.peek(1, value) && value == 2); ++i)
+        std::this_thread::sleep_for(1ms);
+    CHECK(value == 2);
+    CHECK(cache.stats().puts == 1);
+    CHECK(cache.stats().replacements == 0);
+
+    std::this_thread::sleep_until(start + 330ms);
+    CHECK(!cache.peek(1, value));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    CHECK(std::count(causes.begin(), causes.end(), RemovalCause::Replaced) == 0);
+}
+
+int main()
+{
+    testAdaptiveArcGhostRoundTrip();
+    testListenerCauseAndOrder();
+    testListenerReentry();
+    testArcListener();
+    testLruKBatchAdmission();
+    testBufferedBatchDrains();
+    {
+        LRUCache<int, int> lru(16);
+        testSingleFlight(lru);
+        HashLRUCache<int, int> hashLru(16, 4);
+        testSingleFlight(hashLru);
+    }
+    {
+        LRUCache<int, int> lru(16);
+        testTtlExpiry(lru);
+        HashLRUCache<int, int> hashLru(16, 4);
+        testTtlExpiry(hashLru);
+    }
+    {
+        LRUCache<int, int> lru(4);
+        testRefreshKeepsTtl(lru);
+        LFUCache<int, int> lfu(4, 10);
+        testRefreshKeepsTtl(lfu);
+    }
+
+    if (g_failures)
+    {
+        std::cerr << "❌ " << g_failures << " 项检查失败" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ 行为测试全部通过" << std::endl;
+    return 0;
+}
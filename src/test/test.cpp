@@ -81,27 +81,40 @@ void testHotDataAccess()
     const int HOT_KEYS   = 20;     // 热点数据数量
     const int COLD_KEYS  = 5000;   // 冷数据数量
 
-    // 创建六种缓存算法实例，总容量相同
-    LRUCache<int, std::string>     lru(CAPACITY); // 基础LRU
-    LRUKCache<int, std::string>    lruk(2, CAPACITY,
-                                     HOT_KEYS + COLD_KEYS); // k=2, 主缓存容量=CAPACITY
-    HashLRUCache<int, std::string> hashLru(CAPACITY, 4);       // 分片LRU，4个分片
-    LFUCache<int, std::string>     lfu(CAPACITY, 100);         // 基础LFU，maxAverageFreq=100
-    HashLFUCache<int, std::string> hashLfu(CAPACITY,
-                                           100,
-                                           4); // 分片LFU，4个分片，降低maxAverageFreq
-    ARCCache<int, std::string>     arc(CAPACITY / 2, 100); // ARC使用完整容量
+    // 创建十种缓存算法实例，总容量相同
+    LRUCache<int, std::string>         lru(CAPACITY); // 基础LRU
+    LRUKCache<int, std::string>        lruk(2, CAPACITY,
+                                         HOT_KEYS + COLD_KEYS); // k=2, 主缓存容量=CAPACITY
+    HashLRUCache<int, std::string>     hashLru(CAPACITY, 4); // 分片LRU，4个分片
+    ClockCache<int, std::string>       clk(CAPACITY);        // CLOCK近似LRU
+    SLRUCache<int, std::string>        slru(CAPACITY);       // 2Q分段LRU，抗扫描
+    LFUCache<int, std::string>         lfu(CAPACITY, 100);   // 基础LFU，maxAverageFreq=100
+    HashLFUCache<int, std::string>     hashLfu(CAPACITY,
+                                               100,
+                                               4); // 分片LFU，4个分片，降低maxAverageFreq
+    TinyLFUCache<int, std::string>     tinyLfu(CAPACITY);      // W-TinyLFU，频次准入
+    ARCCache<int, std::string>         arc(CAPACITY / 2, 100); // ARC使用完整容量
+    AdaptiveARCCache<int, std::string> adaptiveArc(CAPACITY);  // 单锁ARC，幽灵记录只保存键
 
     std::random_device rd;
     std::mt19937       gen(rd());
 
     // 基类指针指向派生类对象
-    std::array<BaseCache<int, std::string>*, 6> caches =
-        {&lru, &lruk, &hashLru, &lfu, &hashLfu, &arc};
-    std::vector<int>         hits(6, 0);
-    std::vector<int>         get_operations(6, 0);
-    std::vector<double>      executionTimes(6, 0.0);
-    std::vector<std::string> names = {"LRU", "LRU-K", "HashLRU", "LFU", "HashLFU", "ARC"};
+    std::array<BaseCache<int, std::string>*, 10> caches =
+        {&lru, &lruk, &hashLru, &clk, &slru, &lfu, &hashLfu, &tinyLfu, &arc, &adaptiveArc};
+    std::vector<int>         hits(10, 0);
+    std::vector<int>         get_operations(10, 0);
+    std::vector<double>      executionTimes(10, 0.0);
+    std::vector<std::string> names = {"LRU",
+                                      "LRU-K",
+                                      "HashLRU",
+                                      "Clock",
+                                      "SLRU",
+                                      "LFU",
+                                      "HashLFU",
+                                      "TinyLFU",
+                                      "ARC",
+                                      "AdaptiveARC"};
     Timer                    performanceTimer("性能测量", true);
 
     // 为所有的缓存对象进行相同的操作序列测试
@@ -182,24 +195,37 @@ void testLoopPattern()
     const int LOOP_SIZE  = 500;    // 循环范围大小
     const int OPERATIONS = 200000; // 总操作次数
 
-    // 创建六种缓存算法实例，总容量相同
-    LRUCache<int, std::string>     lru(CAPACITY); // 基础LRU
-    LRUKCache<int, std::string>    lruk(2,
-                                     CAPACITY,
-                                     LOOP_SIZE * 2); // k=2, 历史记录容量为循环大小的两倍
-    HashLRUCache<int, std::string> hashLru(CAPACITY, 4); // 分片LRU，4个分片
-    LFUCache<int, std::string>     lfu(CAPACITY, 200);   // 基础LFU，maxAverageFreq=200
-    HashLFUCache<int, std::string> hashLfu(CAPACITY,
-                                           200,
-                                           4); // 分片LFU，4个分片，降低maxAverageFreq
-    ARCCache<int, std::string>     arc(CAPACITY / 2, 200); // ARC使用完整容量
-
-    std::array<BaseCache<int, std::string>*, 6> caches =
-        {&lru, &lruk, &hashLru, &lfu, &hashLfu, &arc};
-    std::vector<int>         hits(6, 0);
-    std::vector<int>         get_operations(6, 0);
-    std::vector<double>      executionTimes(6, 0.0);
-    std::vector<std::string> names = {"LRU", "LRU-K", "HashLRU", "LFU", "HashLFU", "ARC"};
+    // 创建十种缓存算法实例，总容量相同
+    LRUCache<int, std::string>         lru(CAPACITY); // 基础LRU
+    LRUKCache<int, std::string>        lruk(2,
+                                         CAPACITY,
+                                         LOOP_SIZE * 2); // k=2, 历史记录容量为循环大小的两倍
+    HashLRUCache<int, std::string>     hashLru(CAPACITY, 4); // 分片LRU，4个分片
+    ClockCache<int, std::string>       clk(CAPACITY);        // CLOCK近似LRU
+    SLRUCache<int, std::string>        slru(CAPACITY);       // 2Q分段LRU，抗扫描
+    LFUCache<int, std::string>         lfu(CAPACITY, 200);   // 基础LFU，maxAverageFreq=200
+    HashLFUCache<int, std::string>     hashLfu(CAPACITY,
+                                               200,
+                                               4); // 分片LFU，4个分片，降低maxAverageFreq
+    TinyLFUCache<int, std::string>     tinyLfu(CAPACITY);      // W-TinyLFU，频次准入
+    ARCCache<int, std::string>         arc(CAPACITY / 2, 200); // ARC使用完整容量
+    AdaptiveARCCache<int, std::string> adaptiveArc(CAPACITY);  // 单锁ARC，幽灵记录只保存键
+
+    std::array<BaseCache<int, std::string>*, 10> caches =
+        {&lru, &lruk, &hashLru, &clk, &slru, &lfu, &hashLfu, &tinyLfu, &arc, &adaptiveArc};
+    std::vector<int>         hits(10, 0);
+    std::vector<int>         get_operations(10, 0);
+    std::vector<double>      executionTimes(10, 0.0);
+    std::vector<std::string> names = {"LRU",
+                                      "LRU-K",
+                                      "HashLRU",
+                                      "Clock",
+                                      "SLRU",
+                                      "LFU",
+                                      "HashLFU",
+                                      "TinyLFU",
+                                      "ARC",
+                                      "AdaptiveARC"};
     Timer                    performanceTimer("性能测量", true);
 
     std::random_device rd;
@@ -290,24 +316,37 @@ void testWorkloadShift()
     const int OPERATIONS   = 8000;           // 减少操作次数以避免潜在的死循环
     const int PHASE_LENGTH = OPERATIONS / 5; // 每个阶段的长度
 
-    // 创建六种缓存算法实例，总容量相同
-    LRUCache<int, std::string>     lru(CAPACITY);          // 基础LRU
-    LRUKCache<int, std::string>    lruk(2, CAPACITY, 500); // k=2, 历史记录容量500
-    HashLRUCache<int, std::string> hashLru(CAPACITY, 4);   // 分片LRU，4个分片
-    LFUCache<int, std::string>     lfu(CAPACITY, 300);     // 基础LFU，maxAverageFreq=300
-    HashLFUCache<int, std::string> hashLfu(CAPACITY,
-                                           300,
-                                           4); // 分片LFU，4个分片，降低maxAverageFreq
-    ARCCache<int, std::string>     arc(CAPACITY / 2, 300); // ARC使用完整容量
+    // 创建十种缓存算法实例，总容量相同
+    LRUCache<int, std::string>         lru(CAPACITY);          // 基础LRU
+    LRUKCache<int, std::string>        lruk(2, CAPACITY, 500); // k=2, 历史记录容量500
+    HashLRUCache<int, std::string>     hashLru(CAPACITY, 4);   // 分片LRU，4个分片
+    ClockCache<int, std::string>       clk(CAPACITY);          // CLOCK近似LRU
+    SLRUCache<int, std::string>        slru(CAPACITY);         // 2Q分段LRU，抗扫描
+    LFUCache<int, std::string>         lfu(CAPACITY, 300);     // 基础LFU，maxAverageFreq=300
+    HashLFUCache<int, std::string>     hashLfu(CAPACITY,
+                                               300,
+                                               4); // 分片LFU，4个分片，降低maxAverageFreq
+    TinyLFUCache<int, std::string>     tinyLfu(CAPACITY);      // W-TinyLFU，频次准入
+    ARCCache<int, std::string>         arc(CAPACITY / 2, 300); // ARC使用完整容量
+    AdaptiveARCCache<int, std::string> adaptiveArc(CAPACITY);  // 单锁ARC，幽灵记录只保存键
 
     std::random_device                          rd;
     std::mt19937                                gen(rd());
-    std::array<BaseCache<int, std::string>*, 6> caches =
-        {&lru, &lruk, &hashLru, &lfu, &hashLfu, &arc};
-    std::vector<int>         hits(6, 0);
-    std::vector<int>         get_operations(6, 0);
-    std::vector<double>      executionTimes(6, 0.0);
-    std::vector<std::string> names = {"LRU", "LRU-K", "HashLRU", "LFU", "HashLFU", "ARC"};
+    std::array<BaseCache<int, std::string>*, 10> caches =
+        {&lru, &lruk, &hashLru, &clk, &slru, &lfu, &hashLfu, &tinyLfu, &arc, &adaptiveArc};
+    std::vector<int>         hits(10, 0);
+    std::vector<int>         get_operations(10, 0);
+    std::vector<double>      executionTimes(10, 0.0);
+    std::vector<std::string> names = {"LRU",
+                                      "LRU-K",
+                                      "HashLRU",
+                                      "Clock",
+                                      "SLRU",
+                                      "LFU",
+                                      "HashLFU",
+                                      "TinyLFU",
+                                      "ARC",
+                                      "AdaptiveARC"};
     Timer                    performanceTimer("性能测量", true);
 
     // 为每种缓存算法运行相同的测试
@@ -424,7 +463,7 @@ void testWorkloadShift()
 void runAllPerformanceTests()
 {
     std::cout << "\n🚀 开始缓存系统综合性能测试 🚀" << std::endl;
-    std::cout << "本次测试将对比 LRU、LRU-K(k=2)、HashLRU、LFU、HashLFU、ARC 六种缓存淘汰策略"
+    std::cout << "本次测试将对比 LRU、LRU-K(k=2)、HashLRU、Clock、SLRU、LFU、HashLFU、TinyLFU、ARC、AdaptiveARC 十种缓存淘汰策略"
               << std::endl;
     std::cout << "测试包含三个场景：热点数据访问、循环扫描、工作负载变化" << std::endl;
     std::cout << std::string(120, '=') << std::endl;
@@ -0,0 +1,110 @@
+// 追踪文件查看工具：打印 Tracer::dump 写出的二进制事件，并按操作、分片和线程汇总
+// 用法：TraceDump <追踪文件> [打印的事件数，默认 50，0 为只看汇总]
+#include "../utils/trace.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+static void printEvent(const TraceEvent& event)
+{
+    std::cout << std::setw(16) << event.timestamp << "  " << std::setw(8) << traceOpName(event.op)
+              << "  shard " << std::setw(4) << event.shard << "  thread " << std::setw(4)
+              << event.thread << "  key 0x" << std::hex << std::setw(16) << std::setfill('0')
+              << event.keyHash << std::dec << std::setfill(' ') << std::endl;
+}
+
+static void printSummary(const std::vector<TraceEvent>& events)
+{
+    std::uint64_t                          ops[kTraceOpCount]{};
+    std::map<std::uint16_t, std::uint64_t> shardEvictions;
+    std::map<std::uint16_t, std::uint64_t> shardEvents;
+    std::map<std::uint32_t, std::uint64_t> threadEvents;
+    std::unordered_set<std::uint64_t>      evicted;
+    std::uint64_t                          regretted = 0; // 被淘汰后又未命中的查询
+
+    for (const TraceEvent& event : events)
+    {
+        auto op = static_cast<int>(event.op);
+        if (op < kTraceOpCount)
+            ops[op]++;
+        shardEvents[event.shard]++;
+        threadEvents[event.thread]++;
+        switch (event.op)
+        {
+        case TraceOp::Evict:
+            shardEvictions[event.shard]++;
+            evicted.insert(event.keyHash);
+            break;
+        case TraceOp::GetMiss:
+            regretted += evicted.count(event.keyHash);
+            break;
+        case TraceOp::Insert:
+            evicted.erase(event.keyHash);
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::uint64_t hits    = ops[static_cast<int>(TraceOp::GetHit)];
+    std::uint64_t lookups = hits + ops[static_cast<int>(TraceOp::GetMiss)];
+
+    std::cout << "\n按操作:" << std::endl;
+    for (int op = 0; op < kTraceOpCount; op++)
+        std::cout << "  " << std::left << std::setw(10) << traceOpName(static_cast<TraceOp>(op))
+                  << std::right << ops[op] << std::endl;
+    if (lookups)
+        std::cout << "  命中率: " << std::fixed << std::setprecision(2) << 100.0 * hits / lookups
+                  << "%" << std::endl;
+    std::cout << "  淘汰后又被查询的未命中: " << regretted << std::endl;
+
+    std::cout << "\n按分片（事件数 / 淘汰数）:" << std::endl;
+    for (const auto& [shard, count] : shardEvents)
+        std::cout << "  shard " << std::setw(4) << shard << "  " << std::setw(10) << count << "  "
+                  << shardEvictions[shard] << std::endl;
+
+    std::cout << "\n按线程（事件数）:" << std::endl;
+    for (const auto& [thread, count] : threadEvents)
+        std::cout << "  thread " << std::setw(4) << thread << "  " << count << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "用法: " << argv[0] << " <追踪文件> [打印的事件数]" << std::endl;
+        return 1;
+    }
+    std::size_t limit = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+
+    TraceFileHeader         header{};
+    std::vector<TraceEvent> events;
+    if (!Tracer::load(argv[1], header, events))
+    {
+        std::cerr << "无法读取追踪文件: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== 追踪文件 " << argv[1] << " ===" << std::endl;
+    std::cout << "事件数: " << header.count << ", 被覆盖的事件数: " << header.dropped << std::endl;
+    if (!events.empty())
+        std::cout << "时间跨度: " << (events.back().timestamp - events.front().timestamp) / 1e6
+                  << " ms" << std::endl;
+
+    if (limit > 0)
+    {
+        std::cout << "\n" << std::setw(16) << "时间戳(ns)" << std::endl;
+        for (std::size_t i = 0; i < events.size() && i < limit; i++) printEvent(events[i]);
+        if (events.size() > limit)
+            std::cout << "... 另有 " << events.size() - limit << " 个事件" << std::endl;
+    }
+
+    printSummary(events);
+    return 0;
+}
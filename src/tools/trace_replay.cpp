@@ -0,0 +1,704 @@
+// 访问轨迹回放工具：把真实访问轨迹流式地回放到各种缓存，报告命中率、字节命中率和吞吐量
+// 用法：TraceReplay <轨迹文件|-> [--format auto|binary|lines|csv] [--columns op,key,size]
+//                   [--cache LRU,ARC,...] [--capacity 1000,100000] [--bytes] [--no-mmap]
+//                   [--convert 输出文件]
+// 轨迹格式：
+//   binary 本工具的定长记录：文件头 "CSREPLY1" 之后每条 16 字节，可由 --convert 从文本格式生成
+//   lines  每行一个键（LIRS），或 "起始块 块数 ..."（ARC），块数大于 1 时展开为连续的块
+//   csv    逗号分隔，默认列为 op,key,size；--columns 按名称指定各列（其余名称的列被忽略），
+//          如 --columns time,key,ksize,size,client,op,ttl；无法识别操作的行（如表头）被跳过
+// 文本格式中全数字的键按整数解析，其他键取哈希。读请求未命中时按大小写入（按需填充），
+// 删除请求只计数（BaseCache 没有删除接口）。
+// 整个轨迹只读取一遍：每批记录依次交给所有 缓存 x 容量 的组合，内存占用与轨迹长度无关。
+#include "../arc/arc.hpp"
+#include "../common/Hash.hpp"
+#include "../lfu/lfu.hpp"
+#include "../lru/lru.hpp"
+#include "../utils/text.hpp"
+#include "../utils/timer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using Key   = std::uint64_t;
+using Size  = std::uint32_t;
+using Cache = BaseCache<Key, Size>;
+
+enum class ReplayOp : std::uint8_t
+{
+    Read,
+    Write,
+    Delete,
+};
+
+/**
+ * @brief 二进制轨迹的定长记录（16 字节，小端）
+ */
+struct ReplayRecord
+{
+    std::uint64_t key;
+    std::uint32_t size; // 对象大小（字节），文本格式未给出时为 1
+    ReplayOp      op;
+    std::uint8_t  reserved[3];
+};
+
+static_assert(sizeof(ReplayRecord) == 16, "replay file layout");
+
+static constexpr char        kReplayMagic[8] = {'C', 'S', 'R', 'E', 'P', 'L', 'Y', '1'};
+static constexpr std::size_t kBatchSize      = 4096;     // 每批交给缓存回放的记录数
+static constexpr std::size_t kChunkSize      = 4 << 20;  // 分块读取的缓冲区大小
+static constexpr std::size_t kWindowSize     = 16 << 20; // mmap 每次推进的窗口大小
+
+/**
+ * @brief 按块提供文件内容：优先 mmap，按窗口推进并释放已读过的页；否则分块读取
+ */
+class ChunkSource
+{
+    std::FILE*        file_{};     // 分块读取的文件
+    std::vector<char> buffer_;     // 分块读取的缓冲区
+    const char*       mapped_{};   // mmap 的起始地址，为空时使用分块读取
+    std::size_t       length_{};   // 映射的长度
+    std::size_t       offset_{};   // 下一个窗口的起始位置
+    bool              ownsFile_{}; // 是否需要关闭 file_（stdin 不关闭）
+
+  public:
+    ~ChunkSource()
+    {
+#ifdef __unix__
+        if (mapped_)
+            munmap(const_cast<char*>(mapped_), length_);
+#endif
+        if (ownsFile_)
+            std::fclose(file_);
+    }
+
+    bool open(const std::string& path, bool useMmap)
+    {
+        if (path == "-")
+        {
+            file_ = stdin;
+            buffer_.resize(kChunkSize);
+            return true;
+        }
+#ifdef __unix__
+        if (useMmap && mapFile(path))
+            return true;
+#endif
+        file_ = std::fopen(path.c_str(), "rb");
+        if (!file_)
+            return false;
+        ownsFile_ = true;
+        buffer_.resize(kChunkSize);
+        return true;
+    }
+
+    bool mapped() const { return mapped_ != nullptr; }
+
+    // 取下一块，返回的数据在下一次调用前有效
+    bool next(std::string_view& chunk)
+    {
+        if (mapped_)
+        {
+            if (offset_ >= length_)
+                return false;
+#ifdef __unix__
+            // 上一个窗口已经处理完，释放它的页，常驻内存不随文件增长
+            if (offset_ >= kWindowSize)
+                madvise(const_cast<char*>(mapped_) + offset_ - kWindowSize, kWindowSize,
+                        MADV_DONTNEED);
+#endif
+            std::size_t size = std::min(kWindowSize, length_ - offset_);
+            chunk            = std::string_view(mapped_ + offset_, size);
+            offset_ += size;
+            return true;
+        }
+        std::size_t size = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+        chunk            = std::string_view(buffer_.data(), size);
+        return size > 0;
+    }
+
+  private:
+#ifdef __unix__
+    bool mapFile(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+                          fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return false;
+        madvise(data, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+        mapped_ = static_cast<const char*>(data);
+        length_ = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+#endif
+};
+
+/**
+ * @brief 流式解析轨迹，每凑满一批记录调用一次 sink；跨块的半条记录留在 carry_ 中拼接
+ */
+template <typename Sink>
+class TraceParser
+{
+    enum class Format
+    {
+        Binary,
+        Lines,
+        Csv,
+    };
+
+    ChunkSource&              source_;
+    Sink&                     sink_;
+    Format                    format_{};
+    int                       opColumn_   = 0; // CSV 中操作、键、大小所在的列，-1 表示没有该列
+    int                       keyColumn_  = 1;
+    int                       sizeColumn_ = 2;
+    std::string               carry_;          // 上一块末尾不完整的行或记录
+    std::vector<ReplayRecord> batch_;          // 凑满 kBatchSize 条后交给 sink
+    std::uint64_t             skipped_{};      // 无法解析而跳过的行
+
+  public:
+    TraceParser(ChunkSource& source, Sink& sink) : source_(source), sink_(sink)
+    {
+        batch_.reserve(kBatchSize);
+    }
+
+    std::uint64_t skipped() const { return skipped_; }
+
+    // 按名称指定 CSV 的各列，缺少 key 列时返回 false
+    bool setColumns(std::string_view names)
+    {
+        int column = 0;
+        opColumn_ = keyColumn_ = sizeColumn_ = -1;
+        for (std::string_view name : split(names, ','))
+        {
+            if (name == "op")
+                opColumn_ = column;
+            else if (name == "key")
+                keyColumn_ = column;
+            else if (name == "size")
+                sizeColumn_ = column;
+            column++;
+        }
+        return keyColumn_ >= 0;
+    }
+
+    /**
+     * @param format auto 时按内容判断：以文件头开始为 binary，首行含逗号为 csv，否则为 lines
+     */
+    bool run(const std::string& format)
+    {
+        std::string_view chunk;
+        if (!source_.next(chunk))
+            return true;
+        if (format == "binary" || (format == "auto" && startsWithMagic(chunk)))
+            format_ = Format::Binary;
+        else if (format == "csv"
+                 || (format == "auto"
+                     && chunk.substr(0, chunk.find('\n')).find(',') != std::string_view::npos))
+            format_ = Format::Csv;
+        else if (format == "lines" || format == "auto")
+            format_ = Format::Lines;
+        else
+            return false;
+
+        if (format_ == Format::Binary)
+        {
+            if (!startsWithMagic(chunk))
+                return false;
+            chunk.remove_prefix(sizeof(kReplayMagic));
+        }
+        do
+        {
+            if (format_ == Format::Binary)
+                consumeBinary(chunk);
+            else
+                consumeText(chunk);
+        } while (source_.next(chunk));
+
+        if (!carry_.empty() && format_ != Format::Binary)
+            parseLine(carry_);
+        else if (!carry_.empty())
+            skipped_++; // 文件末尾不完整的记录
+        flush();
+        return true;
+    }
+
+  private:
+    static bool startsWithMagic(std::string_view chunk)
+    {
+        return chunk.size() >= sizeof(kReplayMagic)
+            && std::memcmp(chunk.data(), kReplayMagic, sizeof(kReplayMagic)) == 0;
+    }
+
+    static std::vector<std::string_view> split(std::string_view text, char separator)
+    {
+        std::vector<std::string_view> fields;
+        std::size_t                   begin = 0;
+        while (true)
+        {
+            std::size_t end = text.find(separator, begin);
+            fields.push_back(trim(text.substr(begin, end - begin)));
+            if (end == std::string_view::npos)
+                return fields;
+            begin = end + 1;
+        }
+    }
+
+    static std::string_view trim(std::string_view text)
+    {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+            text.remove_prefix(1);
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    static bool parseNumber(std::string_view text, std::uint64_t& value)
+    {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size() && !text.empty();
+    }
+
+    // 全数字的键按整数解析，其余取哈希
+    static Key parseKey(std::string_view text)
+    {
+        std::uint64_t key;
+        if (parseNumber(text, key))
+            return key;
+        return DefaultHash<std::string>{}(text);
+    }
+
+    static bool parseOp(std::string_view text, ReplayOp& op)
+    {
+        std::string lower(text);
+        for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (lower == "get" || lower == "gets" || lower == "read" || lower == "r")
+            op = ReplayOp::Read;
+        else if (lower == "set" || lower == "put" || lower == "add" || lower == "replace"
+                 || lower == "write" || lower == "w")
+            op = ReplayOp::Write;
+        else if (lower == "delete" || lower == "del" || lower == "remove")
+            op = ReplayOp::Delete;
+        else
+            return false;
+        return true;
+    }
+
+    void consumeBinary(std::string_view chunk)
+    {
+        constexpr std::size_t kRecord = sizeof(ReplayRecord);
+        if (!carry_.empty())
+        {
+            std::size_t need = kRecord - carry_.size();
+            carry_.append(chunk.substr(0, need));
+            chunk.remove_prefix(std::min(need, chunk.size()));
+            if (carry_.size() < kRecord)
+                return;
+            emitRaw(carry_.data());
+            carry_.clear();
+        }
+        std::size_t whole = chunk.size() / kRecord * kRecord;
+        for (std::size_t offset = 0; offset < whole; offset += kRecord)
+            emitRaw(chunk.data() + offset);
+        carry_.assign(chunk.substr(whole));
+    }
+
+    void consumeText(std::string_view chunk)
+    {
+        std::size_t begin = 0;
+        if (!carry_.empty())
+        {
+            std::size_t newline = chunk.find('\n');
+            if (newline == std::string_view::npos)
+            {
+                carry_.append(chunk);
+                return;
+            }
+            carry_.append(chunk.substr(0, newline));
+            parseLine(carry_);
+            carry_.clear();
+            begin = newline + 1;
+        }
+        std::size_t newline;
+        while ((newline = chunk.find('\n', begin)) != std::string_view::npos)
+        {
+            parseLine(chunk.substr(begin, newline - begin));
+            begin = newline + 1;
+        }
+        carry_.assign(chunk.substr(begin));
+    }
+
+    void parseLine(std::string_view line)
+    {
+        line = trim(line);
+        if (line.empty() || line.front() == '#')
+            return;
+        if (format_ == Format::Csv)
+            parseCsv(line);
+        else
+            parseBlocks(line);
+    }
+
+    // "键" 或 "起始块 块数 ..."
+    void parseBlocks(std::string_view line)
+    {
+        std::size_t      space = line.find_first_of(" \t");
+        std::string_view first = line.substr(0, space);
+        std::uint64_t    count = 1;
+        if (space != std::string_view::npos)
+        {
+            std::string_view rest = trim(line.substr(space + 1));
+            if (!parseNumber(rest.substr(0, rest.find_first_of(" \t")), count) || count == 0)
+                count = 1;
+        }
+        Key key = parseKey(first);
+        for (std::uint64_t i = 0; i < count; i++) emit(key + i, 1, ReplayOp::Read);
+    }
+
+    void parseCsv(std::string_view line)
+    {
+        std::vector<std::string_view> fields = split(line, ',');
+        auto field = [&](int column) -> std::string_view
+        { return column >= 0 && column < static_cast<int>(fields.size()) ? fields[column] : ""; };
+
+        ReplayOp      op   = ReplayOp::Read;
+        std::uint64_t size = 1;
+        if ((opColumn_ >= 0 && !parseOp(field(opColumn_), op)) || field(keyColumn_).empty()
+            || (sizeColumn_ >= 0 && !parseNumber(field(sizeColumn_), size)))
+        {
+            skipped_++;
+            return;
+        }
+        emit(parseKey(field(keyColumn_)), size, op);
+    }
+
+    void emitRaw(const char* data)
+    {
+        ReplayRecord record;
+        std::memcpy(&record, data, sizeof(record));
+        if (record.op > ReplayOp::Delete)
+        {
+            skipped_++;
+            return;
+        }
+        batch_.push_back(record);
+        if (batch_.size() == kBatchSize)
+            flush();
+    }
+
+    void emit(Key key, std::uint64_t size, ReplayOp op)
+    {
+        ReplayRecord record{};
+        record.key  = key;
+        record.size = static_cast<std::uint32_t>(std::clamp<std::uint64_t>(size, 1, UINT32_MAX));
+        record.op   = op;
+        batch_.push_back(record);
+        if (batch_.size() == kBatchSize)
+            flush();
+    }
+
+    void flush()
+    {
+        if (batch_.empty())
+            return;
+        sink_(batch_);
+        batch_.clear();
+    }
+};
+
+/**
+ * @brief 一个 缓存 x 容量 组合的回放结果
+ */
+struct Simulation
+{
+    std::string            name;
+    std::int64_t           capacity;
+    std::unique_ptr<Cache> cache;
+    std::uint64_t          reads{};     // 读请求数
+    std::uint64_t          hits{};      // 读命中数
+    std::uint64_t          readBytes{}; // 读请求的总字节数
+    std::uint64_t          hitBytes{};  // 命中的总字节数
+    std::uint64_t          writes{};    // 写请求数
+    std::uint64_t          deletes{};   // 删除请求数（只计数）
+    double                 seconds{};   // 缓存操作的总耗时，不含读取和解析
+
+    void replay(const std::vector<ReplayRecord>& batch)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (const ReplayRecord& record : batch)
+        {
+            switch (record.op)
+            {
+            case ReplayOp::Read:
+            {
+                Size size;
+                reads++;
+                readBytes += record.size;
+                if (cache->get(record.key, size))
+                {
+                    hits++;
+                    hitBytes += record.size;
+                }
+                else
+                    cache->put(record.key, record.size); // 按需填充
+                break;
+            }
+            case ReplayOp::Write:
+                writes++;
+                cache->put(record.key, record.size);
+                break;
+            case ReplayOp::Delete:
+                deletes++;
+                break;
+            }
+        }
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+static const char* const kCacheNames[] = {"LRU", "LRU-K", "HashLRU", "BufferedLRU", "Clock",
+                                          "SLRU", "HashSLRU", "LFU", "HashLFU", "TinyLFU",
+                                          "ARC", "AdaptiveARC"};
+
+/**
+ * @brief 按名称创建缓存；bytes 为真时容量按字节计，不支持权重的缓存返回空
+ */
+static std::unique_ptr<Cache> makeCache(const std::string& name, std::int64_t capacity, bool bytes)
+{
+    if (bytes)
+    {
+        Weigher<Key, Size> weigher = [](const Key&, const Size& size) { return size; };
+        if (name == "LRU")
+            return std::make_unique<LRUCache<Key, Size>>(capacity, weigher);
+        if (name == "HashLRU")
+            return std::make_unique<HashLRUCache<Key, Size>>(capacity, 0, weigher);
+        if (name == "LFU")
+            return std::make_unique<LFUCache<Key, Size>>(capacity, 100, weigher);
+        if (name == "HashLFU")
+            return std::make_unique<HashLFUCache<Key, Size>>(capacity, 100, 0, weigher);
+        if (name == "ARC")
+            return std::make_unique<ARCCache<Key, Size>>(capacity / 2, 100, weigher);
+        return nullptr;
+    }
+    int entries = static_cast<int>(std::clamp<std::int64_t>(capacity, 1, INT32_MAX));
+    if (name == "LRU")
+        return std::make_unique<LRUCache<Key, Size>>(entries);
+    if (name == "LRU-K")
+        return std::make_unique<LRUKCache<Key, Size>>(2, entries, entries);
+    if (name == "HashLRU")
+        return std::make_unique<HashLRUCache<Key, Size>>(entries, 0);
+    if (name == "BufferedLRU")
+        return std::make_unique<BufferedLRUCache<Key, Size>>(entries);
+    if (name == "Clock")
+        return std::make_unique<ClockCache<Key, Size>>(entries);
+    if (name == "SLRU")
+        return std::make_unique<SLRUCache<Key, Size>>(entries);
+    if (name == "HashSLRU")
+        return std::make_unique<HashSLRUCache<Key, Size>>(entries, 0);
+    if (name == "LFU")
+        return std::make_unique<LFUCache<Key, Size>>(entries, 100);
+    if (name == "HashLFU")
+        return std::make_unique<HashLFUCache<Key, Size>>(entries, 100, 0);
+    if (name == "TinyLFU")
+        return std::make_unique<TinyLFUCache<Key, Size>>(entries);
+    if (name == "ARC")
+        return std::make_unique<ARCCache<Key, Size>>(std::max(entries / 2, 1), 100);
+    if (name == "AdaptiveARC")
+        return std::make_unique<AdaptiveARCCache<Key, Size>>(entries);
+    return nullptr;
+}
+
+static std::vector<std::string> splitList(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::size_t              begin = 0;
+    while (begin < text.size())
+    {
+        std::size_t end = text.find(',', begin);
+        if (end == std::string::npos)
+            end = text.size();
+        if (end > begin)
+            items.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return items;
+}
+
+static void printUsage(const char* program)
+{
+    std::cerr << "用法: " << program
+              << " <轨迹文件|-> [--format auto|binary|lines|csv] [--columns op,key,size]"
+                 " [--cache LRU,ARC,...] [--capacity 1000,100000] [--bytes] [--no-mmap]"
+                 " [--convert 输出文件]"
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string              path    = argv[1];
+    std::string              format  = "auto";
+    std::string              columns = "op,key,size";
+    std::string              convert;
+    std::vector<std::string> caches(std::begin(kCacheNames), std::end(kCacheNames));
+    std::vector<std::string> capacities{"1000", "10000", "100000"};
+    bool                     bytes   = false;
+    bool                     useMmap = true;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg  = argv[i];
+        bool        more = i + 1 < argc;
+        if (arg == "--bytes")
+            bytes = true;
+        else if (arg == "--no-mmap")
+            useMmap = false;
+        else if (arg == "--format" && more)
+            format = argv[++i];
+        else if (arg == "--columns" && more)
+            columns = argv[++i];
+        else if (arg == "--cache" && more)
+            caches = splitList(argv[++i]);
+        else if (arg == "--capacity" && more)
+            capacities = splitList(argv[++i]);
+        else if (arg == "--convert" && more)
+            convert = argv[++i];
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    ChunkSource source;
+    if (!source.open(path, useMmap))
+    {
+        std::cerr << "无法打开轨迹文件: " << path << std::endl;
+        return 1;
+    }
+
+    // --convert：只把轨迹转写为二进制格式，之后的回放可以跳过文本解析
+    if (!convert.empty())
+    {
+        std::FILE* out = std::fopen(convert.c_str(), "wb");
+        if (!out)
+        {
+            std::cerr << "无法写入: " << convert << std::endl;
+            return 1;
+        }
+        std::uint64_t written = 0;
+        bool          ok      = std::fwrite(kReplayMagic, sizeof(kReplayMagic), 1, out) == 1;
+        auto          write   = [&](const std::vector<ReplayRecord>& batch)
+        {
+            ok = ok && std::fwrite(batch.data(), sizeof(ReplayRecord), batch.size(), out)
+                           == batch.size();
+            written += batch.size();
+        };
+        TraceParser<decltype(write)> parser(source, write);
+        if (!parser.setColumns(columns) || !parser.run(format))
+        {
+            std::fclose(out);
+            std::cerr << "无法解析轨迹（格式或列设置有误）" << std::endl;
+            return 1;
+        }
+        ok = std::fclose(out) == 0 && ok;
+        std::cout << "已写入 " << written << " 条记录到 " << convert << "，跳过 "
+                  << parser.skipped() << " 行" << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    std::vector<Simulation> simulations;
+    for (const std::string& capacityText : capacities)
+    {
+        std::int64_t capacity = std::strtoll(capacityText.c_str(), nullptr, 10);
+        if (capacity <= 0)
+            continue;
+        for (const std::string& name : caches)
+        {
+            std::unique_ptr<Cache> cache = makeCache(name, capacity, bytes);
+            if (!cache)
+            {
+                std::cerr << "跳过 " << name << "：未知的缓存，或不支持按字节计容量" << std::endl;
+                continue;
+            }
+            simulations.push_back(Simulation{name, capacity, std::move(cache)});
+        }
+    }
+    if (simulations.empty())
+    {
+        std::cerr << "没有可回放的缓存" << std::endl;
+        return 1;
+    }
+
+    std::uint64_t records = 0;
+    auto          replay  = [&](const std::vector<ReplayRecord>& batch)
+    {
+        records += batch.size();
+        for (Simulation& simulation : simulations) simulation.replay(batch);
+    };
+    TraceParser<decltype(replay)> parser(source, replay);
+    Timer                         timer("replay", true);
+    if (!parser.setColumns(columns) || !parser.run(format))
+    {
+        std::cerr << "无法解析轨迹（格式或列设置有误）" << std::endl;
+        return 1;
+    }
+    double elapsedMs = timer.getElapsedMilliseconds();
+
+    std::cout << "=== 轨迹回放 " << path << " ===" << std::endl;
+    std::cout << "记录数: " << records << ", 跳过: " << parser.skipped()
+              << ", 读取方式: " << (source.mapped() ? "mmap" : "分块读取")
+              << ", 容量单位: " << (bytes ? "字节" : "条目") << ", 总耗时: " << std::fixed
+              << std::setprecision(1) << elapsedMs << " ms" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << pad("缓存", 14, true) << pad("容量", 14, true) << pad("命中率", 12, false)
+              << pad("字节命中率", 16, false) << pad("Mops/s", 14, false) << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    for (const Simulation& simulation : simulations)
+    {
+        double hitRatio  = simulation.reads ? 100.0 * simulation.hits / simulation.reads : 0.0;
+        double byteRatio = simulation.readBytes
+                             ? 100.0 * simulation.hitBytes / simulation.readBytes
+                             : 0.0;
+        double ops  = static_cast<double>(simulation.reads + simulation.writes);
+        double mops = simulation.seconds > 0 ? ops / simulation.seconds / 1e6 : 0.0;
+        std::cout << std::left << std::setw(14) << simulation.name << std::setw(14)
+                  << simulation.capacity << std::right << std::setprecision(2) << std::setw(11)
+                  << hitRatio << "%" << std::setw(15) << byteRatio << "%" << std::setw(14) << mops
+                  << std::endl;
+    }
+    std::cout << std::string(80, '-') << std::endl;
+    return 0;
+}
@@ -1,11 +1,41 @@
 #pragma once
 #include <iostream>
 
-static bool DEBUG = false;
+// 编译期日志级别：高于 CACHE_LOG_LEVEL 的日志连同参数的输出一起被编译掉
+#define CACHE_LOG_OFF   0
+#define CACHE_LOG_ERROR 1
+#define CACHE_LOG_INFO  2
+#define CACHE_LOG_DEBUG 3 // 缓存内部逐操作的调试日志
 
+#ifndef CACHE_LOG_LEVEL
+#define CACHE_LOG_LEVEL CACHE_LOG_OFF
+#endif
+
+enum class LogLevel
+{
+    Error = CACHE_LOG_ERROR,
+    Info  = CACHE_LOG_INFO,
+    Debug = CACHE_LOG_DEBUG,
+};
+
+inline constexpr int kLogLevel = CACHE_LOG_LEVEL;
+
+// 调试日志的运行时开关，只在编译进了调试级别时有意义
+inline bool DEBUG = false;
+
+template <LogLevel Level, typename... Args>
+void logAt(const Args&... args)
+{
+    if constexpr (static_cast<int>(Level) <= kLogLevel)
+    {
+        if (Level != LogLevel::Debug || DEBUG)
+            ((std::cout << args), ...);
+    }
+}
+
+// 调试日志，默认编译掉；参数按引用传递，不会复制键和值
 template <typename... Args>
-void log(Args... args)
+void log(const Args&... args)
 {
-    if (DEBUG)
-        ((std::cout << args), ...);
-}
\ No newline at end of file
+    logAt<LogLevel::Debug>(args...);
+}
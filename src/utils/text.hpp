@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// 按显示宽度补齐（中文字符占两列，std::setw 按字节计数），left 为真时左对齐
+inline std::string pad(const std::string& text, std::size_t width, bool left)
+{
+    std::size_t columns = 0;
+    for (unsigned char c : text)
+    {
+        if ((c & 0xC0) != 0x80)
+            columns += c >= 0xE0 ? 2 : 1;
+    }
+    std::string fill(width > columns ? width - columns : 0, ' ');
+    return left ? text + fill : fill + text;
+}
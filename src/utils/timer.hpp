@@ -10,7 +10,7 @@ class Timer
     Timer(std::string name, bool autoStop = false);
     ~Timer();
 
-    // 获取已经过的毫秒数（不结束计时）
+    // 获取已经过的毫秒数（不结束计时），精确到纳秒
     double getElapsedMilliseconds() const;
 
     void restart();
@@ -39,9 +39,10 @@ inline Timer::~Timer()
 
 inline double Timer::getElapsedMilliseconds() const
 {
-    time_point end      = std::chrono::high_resolution_clock::now();
-    auto       duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start_);
-    return static_cast<double>(duration.count());
+    // 保留小数部分：duration_cast 到 milliseconds 会把不足 1 毫秒的耗时截断为 0
+    using duration = std::chrono::duration<double, std::milli>;
+    time_point end = std::chrono::high_resolution_clock::now();
+    return duration(end - start_).count();
 }
 
 inline void Timer::restart() { start_ = std::chrono::high_resolution_clock::now(); }
\ No newline at end of file
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 编译期追踪开关：为 0 时缓存中的追踪调用连同参数一起被编译掉
+#ifndef CACHE_TRACE
+#define CACHE_TRACE 0
+#endif
+
+inline constexpr bool kTraceEnabled = CACHE_TRACE != 0;
+
+/**
+ * @brief 追踪事件的操作类型
+ */
+enum class TraceOp : std::uint8_t
+{
+    GetHit,  // 命中的查询
+    GetMiss, // 未命中的查询，包括查到已过期的条目
+    Insert,  // 写入新条目
+    Update,  // 覆盖已有条目
+    Reject,  // 权重超限被拒绝的新条目
+    Evict,   // 容量不足被淘汰，或已有条目的新值权重超限
+    Expire,  // 过期移除
+    Remove,  // 主动删除或清空
+};
+
+inline constexpr int kTraceOpCount = 8;
+
+inline const char* traceOpName(TraceOp op)
+{
+    static const char* const names[kTraceOpCount] = {
+        "get-hit", "get-miss", "insert", "update", "reject", "evict", "expire", "remove"};
+    auto index = static_cast<int>(op);
+    return index < kTraceOpCount ? names[index] : "unknown";
+}
+
+/**
+ * @brief 追踪文件中的定长事件（24 字节，小端，按时间戳排序）
+ */
+struct TraceEvent
+{
+    std::uint64_t timestamp; // 相对追踪器创建时刻的纳秒数
+    std::uint64_t keyHash;   // 缓存索引使用的键哈希
+    std::uint32_t thread;    // 线程编号，按线程第一次记录的顺序分配
+    std::uint16_t shard;     // 分片编号，非分片缓存为 0
+    TraceOp       op;
+    std::uint8_t  reserved;
+};
+
+static_assert(sizeof(TraceEvent) == 24, "trace file layout");
+
+/**
+ * @brief 追踪文件头，之后紧跟 count 个 TraceEvent
+ */
+struct TraceFileHeader
+{
+    char          magic[8];  // "CSTRACE1"
+    std::uint32_t version;   // 文件格式版本
+    std::uint32_t eventSize; // sizeof(TraceEvent)
+    std::uint64_t count;     // 事件数
+    std::uint64_t dropped;   // 环形缓冲区写满后被覆盖的事件数
+};
+
+inline constexpr char          kTraceMagic[8] = {'C', 'S', 'T', 'R', 'A', 'C', 'E', '1'};
+inline constexpr std::uint32_t kTraceVersion  = 1;
+
+/**
+ * @brief 进程级的二进制事件追踪器
+ *
+ * 每个线程第一次记录时分配自己的环形缓冲区并登记到追踪器，之后的记录只写本线程的缓冲区，
+ * 没有锁也没有跨线程共享的写入；缓冲区写满后覆盖最旧的事件。每个槽位带序号（seqlock），
+ * 导出时与记录并发也只会跳过正在被改写的槽位，不会读到半个事件。线程退出后缓冲区仍保留，
+ * 它的事件可以照常导出。
+ */
+class Tracer
+{
+  public:
+    static constexpr std::size_t kRingSize = 8192; // 每个线程保留的最近事件数，必须是 2 的幂
+
+  private:
+    static_assert((kRingSize & (kRingSize - 1)) == 0, "ring size must be a power of two");
+
+    using Clock = std::chrono::steady_clock;
+
+    // 序号为奇数时槽位正在写入，写完为 2 * (事件序号 + 1)
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> timestamp{0};
+        std::atomic<std::uint64_t> keyHash{0};
+        std::atomic<std::uint32_t> meta{0}; // 低 16 位为分片，之后 8 位为操作类型
+    };
+
+    struct Ring
+    {
+        std::uint32_t              thread;  // 线程编号
+        std::atomic<std::uint64_t> head{0}; // 已写入的事件总数，只由所属线程修改
+        std::unique_ptr<Slot[]>    slots{new Slot[kRingSize]};
+
+        explicit Ring(std::uint32_t id) : thread(id) {}
+    };
+
+    Clock::time_point                  epoch_ = Clock::now(); // 时间戳的零点
+    mutable std::mutex                 mutex_;                // 保护 rings_ 的登记
+    std::vector<std::unique_ptr<Ring>> rings_;                // 所有线程的缓冲区
+
+    Tracer() = default;
+
+  public:
+    Tracer(const Tracer&)            = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    // 追踪器不析构：退出阶段仍在运行的线程可能还会记录
+    static Tracer& instance()
+    {
+        static Tracer* tracer = new Tracer;
+        return *tracer;
+    }
+
+    static void record(TraceOp op, std::uint64_t keyHash, std::uint16_t shard)
+    {
+        instance().append(op, keyHash, shard);
+    }
+
+    /**
+     * @brief 取出各线程缓冲区中现存的事件，按时间戳排序
+     * @param dropped 不为空时写入已被覆盖的事件数
+     */
+    std::vector<TraceEvent> collect(std::uint64_t* dropped = nullptr) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<TraceEvent>     events;
+        std::uint64_t               lost = 0;
+        for (const auto& ring : rings_)
+        {
+            std::uint64_t head  = ring->head.load(std::memory_order_acquire);
+            std::uint64_t begin = head > kRingSize ? head - kRingSize : 0;
+            lost += begin;
+            for (std::uint64_t i = begin; i < head; i++)
+            {
+                const Slot&   slot     = ring->slots[i & (kRingSize - 1)];
+                std::uint64_t expected = 2 * (i + 1);
+                if (slot.sequence.load(std::memory_order_acquire) != expected)
+                {
+                    lost++; // 导出期间已被新事件覆盖
+                    continue;
+                }
+                // 读到了新事件的任何一个字段，之后读序号时必然看到新的奇数序号
+                TraceEvent    event{};
+                std::uint32_t meta = slot.meta.load(std::memory_order_acquire);
+                event.timestamp    = slot.timestamp.load(std::memory_order_acquire);
+                event.keyHash      = slot.keyHash.load(std::memory_order_acquire);
+                event.thread       = ring->thread;
+                event.shard        = static_cast<std::uint16_t>(meta & 0xffff);
+                event.op           = static_cast<TraceOp>(meta >> 16);
+                if (slot.sequence.load(std::memory_order_relaxed) != expected)
+                {
+                    lost++;
+                    continue;
+                }
+                events.push_back(event);
+            }
+        }
+        std::stable_sort(events.begin(), events.end(),
+                         [](const TraceEvent& a, const TraceEvent& b)
+                         { return a.timestamp < b.timestamp; });
+        if (dropped)
+            *dropped = lost;
+        return events;
+    }
+
+    /**
+     * @brief 把现存事件写入二进制追踪文件，失败时返回 false
+     */
+    bool dump(const std::string& path) const
+    {
+        TraceFileHeader header{};
+        auto            events = collect(&header.dropped);
+        std::memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+        header.version   = kTraceVersion;
+        header.eventSize = sizeof(TraceEvent);
+        header.count     = events.size();
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+               && std::fwrite(events.data(), sizeof(TraceEvent), events.size(), file)
+                      == events.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    /**
+     * @brief 读取 dump 写出的追踪文件，格式不符时返回 false
+     */
+    static bool load(const std::string& path, TraceFileHeader& header,
+                     std::vector<TraceEvent>& events)
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+        bool ok = std::fread(&header, sizeof(header), 1, file) == 1
+               && std::memcmp(header.magic, kTraceMagic, sizeof(header.magic)) == 0
+               && header.version == kTraceVersion && header.eventSize == sizeof(TraceEvent);
+        if (ok)
+        {
+            events.resize(header.count);
+            ok = std::fread(events.data(), sizeof(TraceEvent), events.size(), file)
+              == events.size();
+        }
+        std::fclose(file);
+        return ok;
+    }
+
+  private:
+    void append(TraceOp op, std::uint64_t keyHash, std::uint16_t shard)
+    {
+        Ring&         ring  = localRing();
+        std::uint64_t index = ring.head.load(std::memory_order_relaxed);
+        Slot&         slot  = ring.slots[index & (kRingSize - 1)];
+        std::uint64_t now   = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch_).count());
+
+        // 字段用 release 写入（x86 上与普通写入相同），导出线程读到它们时也能看到前面的奇数序号
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        slot.timestamp.store(now, std::memory_order_release);
+        slot.keyHash.store(keyHash, std::memory_order_release);
+        slot.meta.store(static_cast<std::uint32_t>(op) << 16 | shard, std::memory_order_release);
+        slot.sequence.store(2 * (index + 1), std::memory_order_release);
+        ring.head.store(index + 1, std::memory_order_release);
+    }
+
+    Ring& localRing()
+    {
+        // 线程第一次记录时登记缓冲区，之后只访问本线程的指针
+        thread_local Ring* ring = nullptr;
+        if (!ring)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            rings_.push_back(std::make_unique<Ring>(static_cast<std::uint32_t>(rings_.size())));
+            ring = rings_.back().get();
+        }
+        return *ring;
+    }
+};